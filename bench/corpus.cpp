@@ -0,0 +1,260 @@
+#include "corpus.h"
+
+#include <fstream>
+#include <sstream>
+
+static const char* words[] = {
+    "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit",
+    "sed", "do", "eiusmod", "tempor", "incididunt", "ut", "labore", "et", "dolore",
+    "magna", "aliqua", "enim", "ad", "minim", "veniam", "quis", "nostrud",
+    "exercitation", "ullamco", "laboris", "nisi", "aliquip", "ex", "ea", "commodo"
+};
+
+static const size_t wordCount = sizeof(words) / sizeof(words[0]);
+
+static void appendWords(std::string& output, size_t seed, size_t count)
+{
+    for(size_t i = 0; i < count; ++i) {
+        if(i > 0)
+            output += ' ';
+        output += words[(seed * 7 + i * 13) % wordCount];
+    }
+}
+
+static CorpusDocument longProse(size_t paragraphs)
+{
+    CorpusDocument document;
+    document.name = "long-prose";
+    document.css = "html, body, h1, h2, p, blockquote { display: block }\n"
+                   "body { font-family: serif; font-size: 12pt; line-height: 1.4; margin: 0 }\n"
+                   "h1 { font-size: 24pt; margin: 0 0 12pt }\n"
+                   "h2 { font-size: 16pt; margin: 18pt 0 6pt; page-break-after: avoid }\n"
+                   "p { margin: 0 0 6pt; text-align: justify; text-indent: 1.5em }\n"
+                   "blockquote { margin: 6pt 24pt; font-style: italic }\n"
+                   "em { font-style: italic }\n"
+                   "strong { font-weight: bold }\n"
+                   "a { color: #1a0dab; text-decoration: underline }\n";
+
+    auto& html = document.html;
+    html += "<!DOCTYPE html><html><head><title>Long prose</title></head><body><h1>Long prose</h1>\n";
+    for(size_t i = 0; i < paragraphs; ++i) {
+        if(i % 20 == 0) {
+            html += "<h2>Chapter ";
+            html += std::to_string(i / 20 + 1);
+            html += "</h2>\n";
+        }
+
+        if(i % 37 == 36) {
+            html += "<blockquote>";
+            appendWords(html, i, 24);
+            html += "</blockquote>\n";
+            continue;
+        }
+
+        html += "<p>";
+        appendWords(html, i, 30);
+        html += " <em>";
+        appendWords(html, i + 1, 4);
+        html += "</em> ";
+        appendWords(html, i + 2, 20);
+        html += " <a href=\"#note-";
+        html += std::to_string(i);
+        html += "\">";
+        appendWords(html, i + 3, 2);
+        html += "</a> <strong>";
+        appendWords(html, i + 4, 3);
+        html += "</strong> ";
+        appendWords(html, i + 5, 25);
+        html += ".</p>\n";
+    }
+
+    html += "</body></html>\n";
+    return document;
+}
+
+static CorpusDocument largeTable(size_t rows)
+{
+    CorpusDocument document;
+    document.name = "table-10k-rows";
+    document.css = "html, body, h1 { display: block }\n"
+                   "table { display: table; border-collapse: collapse; width: 100% }\n"
+                   "thead { display: table-header-group }\n"
+                   "tbody { display: table-row-group }\n"
+                   "tr { display: table-row }\n"
+                   "th, td { display: table-cell; padding: 2pt 4pt; border: 0.5pt solid #999 }\n"
+                   "th { font-weight: bold; background-color: #ddd; text-align: left }\n"
+                   "tr.odd td { background-color: #f4f4f4 }\n"
+                   "td.number { text-align: right; font-family: monospace }\n"
+                   "td.status span.ok { color: green }\n"
+                   "td.status span.failed { color: red; font-weight: bold }\n";
+
+    auto& html = document.html;
+    html += "<!DOCTYPE html><html><head><title>Table</title></head><body><h1>Inventory</h1>\n";
+    html += "<table><thead><tr><th>#</th><th>Item</th><th>Category</th><th>Quantity</th><th>Price</th><th>Status</th></tr></thead><tbody>\n";
+    for(size_t i = 0; i < rows; ++i) {
+        html += i % 2 ? "<tr class=\"odd\">" : "<tr class=\"even\">";
+        html += "<td class=\"number\">";
+        html += std::to_string(i + 1);
+        html += "</td><td>";
+        appendWords(html, i, 3);
+        html += "</td><td>";
+        html += words[i % wordCount];
+        html += "</td><td class=\"number\">";
+        html += std::to_string((i * 7919) % 1000);
+        html += "</td><td class=\"number\">";
+        html += std::to_string((i * 104729) % 10000 / 100.0).substr(0, 6);
+        html += "</td><td class=\"status\">";
+        html += i % 11 ? "<span class=\"ok\">ok</span>" : "<span class=\"failed\">failed</span>";
+        html += "</td></tr>\n";
+    }
+
+    html += "</tbody></table></body></html>\n";
+    return document;
+}
+
+static CorpusDocument deepNesting(size_t trees, size_t depth)
+{
+    CorpusDocument document;
+    document.name = "deep-nesting";
+    document.css = "html, body, div, section { display: block }\n"
+                   "div.level { margin-left: 1px; padding: 0 }\n"
+                   "section div.level div.level { border-left: 0.5pt solid #ccc }\n"
+                   "section .level .level .leaf span { color: #333 }\n"
+                   "body > section > div.level { margin-top: 4pt }\n";
+
+    auto& html = document.html;
+    html += "<!DOCTYPE html><html><head><title>Deep nesting</title></head><body>\n";
+    for(size_t i = 0; i < trees; ++i) {
+        html += "<section>";
+        for(size_t j = 0; j < depth; ++j)
+            html += "<div class=\"level\">";
+        html += "<div class=\"leaf\"><span>";
+        appendWords(html, i, 8);
+        html += "</span></div>";
+        for(size_t j = 0; j < depth; ++j)
+            html += "</div>";
+        html += "</section>\n";
+    }
+
+    html += "</body></html>\n";
+    return document;
+}
+
+static CorpusDocument classHeavy(size_t classes, size_t elements)
+{
+    CorpusDocument document;
+    document.name = "class-heavy-css";
+
+    auto& css = document.css;
+    css += "html, body, div, p { display: block }\n";
+    for(size_t i = 0; i < classes; ++i) {
+        css += ".c" + std::to_string(i) + " { color: #";
+        css += std::to_string(100000 + (i * 7919) % 900000);
+        css += "; margin-left: " + std::to_string(i % 12) + "px }\n";
+        if(i % 3 == 0)
+            css += ".c" + std::to_string(i) + " .c" + std::to_string((i * 31) % classes) + " > span { font-weight: bold }\n";
+        if(i % 5 == 0) {
+            css += "div.c" + std::to_string(i) + ".c" + std::to_string((i + 1) % classes);
+            css += " p { padding: " + std::to_string(i % 4) + "px }\n";
+        }
+    }
+
+    auto& html = document.html;
+    html += "<!DOCTYPE html><html><head><title>Class heavy</title></head><body>\n";
+    for(size_t i = 0; i < elements; ++i) {
+        html += "<div class=\"";
+        for(size_t j = 0; j < 4; ++j) {
+            if(j > 0)
+                html += ' ';
+            html += 'c' + std::to_string((i * 17 + j * 101) % classes);
+        }
+
+        html += "\"><p class=\"c" + std::to_string((i * 31) % classes) + "\"><span>";
+        appendWords(html, i, 6);
+        html += "</span> ";
+        appendWords(html, i + 1, 6);
+        html += "</p></div>\n";
+    }
+
+    html += "</body></html>\n";
+    return document;
+}
+
+static CorpusDocument flexDashboard(size_t rows, size_t columns)
+{
+    CorpusDocument document;
+    document.name = "flex-dashboard";
+    document.css = "html, body, header, main, div, h1, h3 { display: block }\n"
+                   "body { font-family: sans-serif; font-size: 10pt; margin: 0 }\n"
+                   "header { display: flex; justify-content: space-between; align-items: center; padding: 8pt; background-color: #263238; color: white }\n"
+                   ".row { display: flex; flex-direction: row; flex-wrap: wrap; margin: 4pt 0 }\n"
+                   ".card { flex: 1 1 0; margin: 4pt; padding: 6pt; border: 1pt solid #cfd8dc; border-radius: 4pt }\n"
+                   ".card .title { font-weight: bold; color: #455a64 }\n"
+                   ".card .value { font-size: 18pt; margin: 4pt 0 }\n"
+                   ".card .trend { display: flex; justify-content: flex-end }\n"
+                   ".trend .up { color: #2e7d32 }\n"
+                   ".trend .down { color: #c62828 }\n"
+                   ".spark { display: flex; align-items: flex-end; height: 24pt }\n"
+                   ".spark div { flex: 1; margin-right: 1pt; background-color: #90a4ae }\n";
+
+    auto& html = document.html;
+    html += "<!DOCTYPE html><html><head><title>Dashboard</title></head><body>\n";
+    html += "<header><h1>Operations</h1><span>Updated hourly</span></header><main>\n";
+    for(size_t i = 0; i < rows; ++i) {
+        html += "<div class=\"row\">";
+        for(size_t j = 0; j < columns; ++j) {
+            auto index = i * columns + j;
+            html += "<div class=\"card\"><div class=\"title\">";
+            appendWords(html, index, 2);
+            html += "</div><div class=\"value\">";
+            html += std::to_string((index * 7919) % 100000);
+            html += "</div><div class=\"spark\">";
+            for(size_t k = 0; k < 12; ++k) {
+                html += "<div style=\"height: ";
+                html += std::to_string(10 + (index * 31 + k * 17) % 90);
+                html += "%\"></div>";
+            }
+
+            html += "</div><div class=\"trend\">";
+            html += index % 3 ? "<span class=\"up\">+" : "<span class=\"down\">-";
+            html += std::to_string(index % 17);
+            html += "%</span></div></div>";
+        }
+
+        html += "</div>\n";
+    }
+
+    html += "</main></body></html>\n";
+    return document;
+}
+
+CorpusDocumentList syntheticCorpus()
+{
+    CorpusDocumentList documents;
+    documents.push_back(longProse(3000));
+    documents.push_back(largeTable(10000));
+    documents.push_back(deepNesting(40, 200));
+    documents.push_back(classHeavy(1500, 3000));
+    documents.push_back(flexDashboard(100, 4));
+    return documents;
+}
+
+static bool readFile(const std::string& filename, std::string& content)
+{
+    std::ifstream input(filename, std::ios::binary);
+    if(!input.is_open())
+        return false;
+    std::ostringstream ss;
+    ss << input.rdbuf();
+    content = ss.str();
+    return true;
+}
+
+bool loadCorpusDocument(const std::string& name, const std::string& htmlFilename, const std::string& cssFilename, CorpusDocument& document)
+{
+    document.name = name;
+    document.css.clear();
+    if(!readFile(htmlFilename, document.html))
+        return false;
+    return cssFilename.empty() || readFile(cssFilename, document.css);
+}
@@ -0,0 +1,18 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <string>
+#include <vector>
+
+struct CorpusDocument {
+    std::string name;
+    std::string html;
+    std::string css;
+};
+
+using CorpusDocumentList = std::vector<CorpusDocument>;
+
+CorpusDocumentList syntheticCorpus();
+bool loadCorpusDocument(const std::string& name, const std::string& htmlFilename, const std::string& cssFilename, CorpusDocument& document);
+
+#endif // CORPUS_H
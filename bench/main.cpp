@@ -0,0 +1,423 @@
+#include "corpus.h"
+
+#include "htmlbook.h"
+#include "htmltokenizer.h"
+#include "htmlparser.h"
+#include "htmldocument.h"
+#include "pdfwriter.h"
+#include "resource.h"
+#include "boxview.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+using namespace htmlbook;
+
+using Clock = std::chrono::steady_clock;
+
+class CountingResource final : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream)
+        : m_upstream(upstream)
+    {}
+
+    size_t bytes() const { return m_bytes; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) final
+    {
+        m_bytes += bytes;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) final
+    {
+        m_upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+    size_t m_bytes{0};
+};
+
+class NullBuffer final : public std::streambuf {
+public:
+    size_t bytes() const { return m_bytes; }
+
+protected:
+    int_type overflow(int_type ch) final
+    {
+        m_bytes += 1;
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char_type*, std::streamsize count) final
+    {
+        m_bytes += count;
+        return count;
+    }
+
+private:
+    size_t m_bytes{0};
+};
+
+enum class Phase {
+    Tokenize,
+    Parse,
+    StyleSheetCold,
+    StyleSheetWarm,
+    Cascade,
+    Build,
+    Layout,
+    Serialize
+};
+
+constexpr size_t kNumPhases = 8;
+
+static const char* phaseNames[kNumPhases] = {
+    "tokenize",
+    "parse",
+    "stylesheet-cold",
+    "stylesheet-warm",
+    "cascade",
+    "build",
+    "layout",
+    "serialize"
+};
+
+static bool isStyleSheetPhase(Phase phase)
+{
+    return phase == Phase::StyleSheetCold || phase == Phase::StyleSheetWarm;
+}
+
+static bool isTreePhase(Phase phase)
+{
+    return phase == Phase::Parse || phase == Phase::Cascade || phase == Phase::Build || phase == Phase::Layout;
+}
+
+struct PhaseResult {
+    double milliseconds{0};
+    size_t heapBytes{0};
+};
+
+struct DocumentResult {
+    std::string name;
+    size_t htmlBytes{0};
+    size_t cssBytes{0};
+    size_t tokens{0};
+    size_t nodes{0};
+    size_t elements{0};
+    size_t pages{0};
+    size_t pdfBytes{0};
+    size_t heapBytes{0};
+    size_t styles{0};
+    size_t uniqueStyles{0};
+    PhaseResult phases[kNumPhases];
+};
+
+static CountingResource* counter = nullptr;
+
+class PhaseTimer {
+public:
+    PhaseTimer(DocumentResult& result, Phase phase)
+        : m_result(result.phases[static_cast<size_t>(phase)])
+        , m_heapBytes(counter->bytes())
+        , m_start(Clock::now())
+    {}
+
+    ~PhaseTimer()
+    {
+        m_result.milliseconds += std::chrono::duration<double, std::milli>(Clock::now() - m_start).count();
+        m_result.heapBytes += counter->bytes() - m_heapBytes;
+    }
+
+private:
+    PhaseResult& m_result;
+    size_t m_heapBytes;
+    Clock::time_point m_start;
+};
+
+static void countNodes(const ContainerNode* node, size_t& nodes, size_t& elements)
+{
+    for(auto child = node->firstChild(); child; child = child->nextSibling()) {
+        nodes += 1;
+        if(child->isElementNode())
+            elements += 1;
+        if(auto container = to<ContainerNode>(child)) {
+            countNodes(container, nodes, elements);
+        }
+    }
+}
+
+static void cascade(Document* document, const ContainerNode* node, const RefPtr<BoxStyle>& parentStyle)
+{
+    for(auto child = node->firstChild(); child; child = child->nextSibling()) {
+        if(auto element = to<Element>(child)) {
+            auto style = document->styleForElement(element, parentStyle);
+            if(style == nullptr)
+                continue;
+            cascade(document, element, style);
+        }
+    }
+}
+
+static void runPipeline(const CorpusDocument& input, DocumentResult& result)
+{
+    auto heapBytes = counter->bytes();
+
+    Book book(PageSize::A4);
+    book.load({});
+
+    {
+        PhaseTimer timer(result, Phase::Tokenize);
+        Heap heap(1024 * 25);
+        HTMLTokenizer tokenizer(input.html, &heap);
+        size_t tokens = 0;
+        while(!tokenizer.atEOF()) {
+            tokenizer.nextToken();
+            tokens += 1;
+        }
+
+        result.tokens = tokens;
+    }
+
+    auto document = HTMLDocument::create(&book);
+    {
+        PhaseTimer timer(result, Phase::Parse);
+        HTMLParser(document.get(), input.html).parse();
+    }
+
+    Book::clearStyleSheetCache();
+    {
+        PhaseTimer timer(result, Phase::StyleSheetCold);
+        document->addStyleSheet(input.css);
+    }
+
+    auto styleDocument = HTMLDocument::create(&book);
+    HTMLParser(styleDocument.get(), input.html).parse();
+    {
+        PhaseTimer timer(result, Phase::StyleSheetWarm);
+        styleDocument->addStyleSheet(input.css);
+    }
+
+    {
+        PhaseTimer timer(result, Phase::Cascade);
+        cascade(styleDocument.get(), styleDocument.get(), BoxStyle::create(styleDocument.get(), PseudoType::None, Display::Block));
+    }
+
+    styleDocument.reset();
+
+    {
+        PhaseTimer timer(result, Phase::Build);
+        document->build();
+    }
+
+    auto view = to<BoxView>(document->box());
+    {
+        PhaseTimer timer(result, Phase::Layout);
+        view->layout();
+    }
+
+    {
+        PhaseTimer timer(result, Phase::Serialize);
+        NullBuffer buffer;
+        std::ostream output(&buffer);
+        PDFWriter writer(output, &book);
+        auto pages = view->pageCount(book.viewportHeight());
+        for(size_t index = 0; index < pages; ++index)
+            writer.writePage(view, index);
+        writer.finish();
+        result.pages = pages;
+        result.pdfBytes = buffer.bytes();
+    }
+
+    result.nodes = 0;
+    result.elements = 0;
+    countNodes(document.get(), result.nodes, result.elements);
+    result.styles = document->styleSheet().styleCount();
+    result.uniqueStyles = document->styleSheet().uniqueStyleCount();
+    result.heapBytes += counter->bytes() - heapBytes;
+}
+
+static DocumentResult run(const CorpusDocument& input, int iterations)
+{
+    DocumentResult result;
+    result.name = input.name;
+    result.htmlBytes = input.html.size();
+    result.cssBytes = input.css.size();
+
+    runPipeline(input, result);
+    result.heapBytes = 0;
+    for(auto& phase : result.phases)
+        phase = PhaseResult();
+    for(int i = 0; i < iterations; ++i)
+        runPipeline(input, result);
+    result.heapBytes /= iterations;
+    for(auto& phase : result.phases) {
+        phase.milliseconds /= iterations;
+        phase.heapBytes /= iterations;
+    }
+
+    return result;
+}
+
+static double megabytesPerSecond(size_t bytes, double milliseconds)
+{
+    if(milliseconds <= 0)
+        return 0;
+    return bytes / (1024.0 * 1024.0) / (milliseconds / 1000.0);
+}
+
+static double itemsPerSecond(size_t items, double milliseconds)
+{
+    if(milliseconds <= 0)
+        return 0;
+    return items / (milliseconds / 1000.0);
+}
+
+static std::string escapeJson(const std::string& value)
+{
+    std::string output;
+    for(auto cc : value) {
+        if(cc == '"' || cc == '\\') {
+            output += '\\';
+            output += cc;
+        } else if(static_cast<unsigned char>(cc) < 0x20) {
+            output += ' ';
+        } else {
+            output += cc;
+        }
+    }
+
+    return output;
+}
+
+static void writeJson(std::ostream& output, const std::vector<DocumentResult>& results, int iterations)
+{
+    output << std::fixed << std::setprecision(3);
+    output << "{\n";
+    output << "  \"iterations\": " << iterations << ",\n";
+    output << "  \"documents\": [\n";
+    for(size_t i = 0; i < results.size(); ++i) {
+        auto& result = results[i];
+        output << "    {\n";
+        output << "      \"name\": \"" << escapeJson(result.name) << "\",\n";
+        output << "      \"htmlBytes\": " << result.htmlBytes << ",\n";
+        output << "      \"cssBytes\": " << result.cssBytes << ",\n";
+        output << "      \"tokens\": " << result.tokens << ",\n";
+        output << "      \"nodes\": " << result.nodes << ",\n";
+        output << "      \"elements\": " << result.elements << ",\n";
+        output << "      \"pages\": " << result.pages << ",\n";
+        output << "      \"pdfBytes\": " << result.pdfBytes << ",\n";
+        output << "      \"heapBytes\": " << result.heapBytes << ",\n";
+        output << "      \"styles\": " << result.styles << ",\n";
+        output << "      \"uniqueStyles\": " << result.uniqueStyles << ",\n";
+        output << "      \"phases\": {\n";
+        for(size_t j = 0; j < kNumPhases; ++j) {
+            auto& phase = result.phases[j];
+            auto bytes = isStyleSheetPhase(static_cast<Phase>(j)) ? result.cssBytes : result.htmlBytes;
+            output << "        \"" << phaseNames[j] << "\": {";
+            output << "\"ms\": " << phase.milliseconds << ", ";
+            output << "\"mbPerSec\": " << megabytesPerSecond(bytes, phase.milliseconds) << ", ";
+            if(isTreePhase(static_cast<Phase>(j)))
+                output << "\"nodesPerSec\": " << itemsPerSecond(result.nodes, phase.milliseconds) << ", ";
+            output << "\"heapBytes\": " << phase.heapBytes << "}";
+            output << (j + 1 < kNumPhases ? ",\n" : "\n");
+        }
+
+        output << "      }\n";
+        output << "    }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    output << "  ]\n";
+    output << "}\n";
+}
+
+static void writeSummary(std::ostream& output, const DocumentResult& result)
+{
+    output << std::fixed << std::setprecision(2);
+    output << result.name << ": " << result.htmlBytes << " bytes, " << result.nodes << " nodes, "
+           << result.pages << " pages, " << result.heapBytes << " heap bytes, "
+           << result.uniqueStyles << "/" << result.styles << " unique styles" << std::endl;
+    for(size_t j = 0; j < kNumPhases; ++j) {
+        auto& phase = result.phases[j];
+        output << "  " << std::left << std::setw(16) << phaseNames[j] << std::right
+               << std::setw(10) << phase.milliseconds << " ms";
+        if(isTreePhase(static_cast<Phase>(j)))
+            output << std::setw(12) << itemsPerSecond(result.nodes, phase.milliseconds) << " nodes/s";
+        output << std::endl;
+    }
+}
+
+static void usage()
+{
+    std::cerr << "usage: htmlbook-bench [-n iterations] [-o output.json] [file.html[:file.css] ...]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    counter = new CountingResource(std::pmr::new_delete_resource());
+    std::pmr::set_default_resource(counter);
+
+    int iterations = 3;
+    std::string outputFilename("htmlbook-bench.json");
+    std::vector<std::string> filenames;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if(std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outputFilename = argv[++i];
+        } else if(argv[i][0] == '-') {
+            usage();
+            return 1;
+        } else {
+            filenames.push_back(argv[i]);
+        }
+    }
+
+    CorpusDocumentList documents;
+    if(filenames.empty()) {
+        documents = syntheticCorpus();
+        documents.emplace_back();
+        std::string directory(HTMLBOOK_BENCH_CORPUS_DIR);
+        if(!loadCorpusDocument("article", directory + "/article.html", directory + "/article.css", documents.back())) {
+            std::cerr << "htmlbook-bench: unable to read the bundled corpus in " << directory << std::endl;
+            return 1;
+        }
+    }
+
+    for(auto& filename : filenames) {
+        auto separator = filename.find(':');
+        auto htmlFilename = filename.substr(0, separator);
+        auto cssFilename = separator == std::string::npos ? std::string() : filename.substr(separator + 1);
+        documents.emplace_back();
+        if(!loadCorpusDocument(htmlFilename, htmlFilename, cssFilename, documents.back())) {
+            std::cerr << "htmlbook-bench: unable to read " << filename << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<DocumentResult> results;
+    for(auto& document : documents) {
+        results.push_back(run(document, iterations));
+        writeSummary(std::cout, results.back());
+    }
+
+    std::ofstream output(outputFilename);
+    if(!output.is_open()) {
+        std::cerr << "htmlbook-bench: unable to write " << outputFilename << std::endl;
+        return 1;
+    }
+
+    writeJson(output, results, iterations);
+    return 0;
+}
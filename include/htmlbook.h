@@ -111,6 +111,19 @@ enum class PageOrientation {
     Landscape
 };
 
+enum class BookStage {
+    Empty,
+    Parsing,
+    Layout,
+    Rendering,
+    Finished
+};
+
+enum class BookError {
+    None,
+    MemoryLimitExceeded
+};
+
 class HTMLBOOK_API ResourceClient {
 public:
     /**
@@ -145,9 +158,70 @@ public:
     virtual bool loadFont(const std::string_view& family, float width, float weight, float slope, std::vector<char>& data) = 0;
 };
 
+class HTMLBOOK_API HugePageResource final : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief HugePageResource
+     */
+    HugePageResource() = default;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) final;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) final;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final;
+};
+
+class HTMLBOOK_API BlockPoolResource final : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief BlockPoolResource
+     * @param maxRetainedBytes
+     * @param upstream
+     */
+    explicit BlockPoolResource(size_t maxRetainedBytes = 1024 * 1024 * 64, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    /**
+     * @brief ~BlockPoolResource
+     */
+    ~BlockPoolResource() final;
+
+    /**
+     * @brief release
+     */
+    void release();
+
+    /**
+     * @brief retainedBytes
+     * @return
+     */
+    size_t retainedBytes() const { return m_retainedBytes; }
+
+    /**
+     * @brief upstream
+     * @return
+     */
+    std::pmr::memory_resource* upstream() const { return m_upstream; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) final;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) final;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr size_t kNumSizeClasses = 48;
+    FreeBlock* m_freeBlocks[kNumSizeClasses] = {};
+    size_t m_maxRetainedBytes;
+    size_t m_retainedBytes{0};
+    std::pmr::memory_resource* m_upstream;
+};
+
 using Heap = std::pmr::monotonic_buffer_resource;
 
 class HTMLDocument;
+class HeapResource;
 
 class HTMLBOOK_API Book {
 public:
@@ -176,6 +250,42 @@ public:
      */
     const PageSize& pageSize() const;
 
+    /**
+     * @brief setPageOrientation
+     * @param orientation
+     */
+    void setPageOrientation(PageOrientation orientation);
+
+    /**
+     * @brief pageOrientation
+     * @return
+     */
+    PageOrientation pageOrientation() const;
+
+    /**
+     * @brief setPageMargins
+     * @param margins
+     */
+    void setPageMargins(const PageMargins& margins);
+
+    /**
+     * @brief pageMargins
+     * @return
+     */
+    const PageMargins& pageMargins() const;
+
+    /**
+     * @brief pageWidth
+     * @return
+     */
+    float pageWidth() const;
+
+    /**
+     * @brief pageHeight
+     * @return
+     */
+    float pageHeight() const;
+
     /**
      * @brief setTitle
      * @param title
@@ -290,6 +400,73 @@ public:
      */
     void clear();
 
+    /**
+     * @brief setMemoryResource
+     * @param resource
+     * @note Parsed author stylesheets are cached process-wide and shared between books.
+     * The cache allocates from the default memory resource within its own fixed byte
+     * budget, so cached sheets bypass this resource and the memory limit.
+     */
+    void setMemoryResource(std::pmr::memory_resource* resource);
+
+    /**
+     * @brief clearStyleSheetCache
+     * @note Drops every parsed author stylesheet from the process-wide cache. Books that
+     * already hold a cached sheet keep it alive until they are cleared.
+     */
+    static void clearStyleSheetCache();
+
+    /**
+     * @brief memoryResource
+     * @return
+     */
+    std::pmr::memory_resource* memoryResource() const;
+
+    /**
+     * @brief setMemoryLimit
+     * @param bytes
+     * @note The limit covers the document heap and its spill only. Containers that
+     * allocate from the default memory resource, std::vector members and the
+     * process-wide stylesheet cache are not counted.
+     */
+    void setMemoryLimit(size_t bytes);
+
+    /**
+     * @brief memoryLimit
+     * @return
+     */
+    size_t memoryLimit() const;
+
+    /**
+     * @brief stage
+     * @return
+     */
+    BookStage stage() const { return m_stage; }
+
+    /**
+     * @brief error
+     * @return
+     */
+    BookError error() const { return m_error; }
+
+    /**
+     * @brief setHeapSizeHint
+     * @param bytes
+     */
+    void setHeapSizeHint(size_t bytes);
+
+    /**
+     * @brief heapSizeHint
+     * @return
+     */
+    size_t heapSizeHint() const;
+
+    /**
+     * @brief heapCapacity
+     * @return
+     */
+    size_t heapCapacity() const;
+
     /**
      * @brief empty
      * @return
@@ -299,8 +476,11 @@ public:
     /**
      * @brief pageCount
      * @return
+     * @note Builds and lays out the document on first use. If that exceeds the memory
+     * limit, the document is dropped, stage() stays at Layout and error() reports
+     * MemoryLimitExceeded.
      */
-    size_t pageCount() const;
+    size_t pageCount();
 
     /**
      * @brief save
@@ -333,8 +513,14 @@ public:
     Heap* heap() const { return m_heap.get(); }
 
 private:
+    std::unique_ptr<HeapResource> m_heapResource;
     std::unique_ptr<Heap> m_heap;
     std::unique_ptr<HTMLDocument> m_document;
+    size_t m_heapSizeHint{0};
+    void fail(BookError error);
+
+    BookStage m_stage{BookStage::Empty};
+    BookError m_error{BookError::None};
     PageSize m_pageSize;
     PageOrientation m_pageOrientation;
     PageMargins m_pageMargins;
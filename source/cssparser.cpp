@@ -8,7 +8,8 @@ namespace htmlbook {
 
 void CSSParser::parseSheet(CSSRuleList& rules, const std::string_view& content)
 {
-    CSSTokenizer tokenizer(content);
+    m_source = HeapString::create(m_heap, content);
+    CSSTokenizer tokenizer(m_source);
     auto input = tokenizer.tokenize();
     while(!input.empty()) {
         input.consumeWhitespace();
@@ -34,6 +35,22 @@ void CSSParser::parseStyle(CSSPropertyList& properties, const std::string_view&
     consumeDeclaractionList(input, properties);
 }
 
+void CSSParser::parseValue(CSSPropertyList& properties, CSSPropertyID id, const std::string_view& content)
+{
+    CSSTokenizer tokenizer(content);
+    auto input = tokenizer.tokenize();
+    input.consumeWhitespace();
+    if(input.empty())
+        return;
+    auto end = input.end();
+    while(end[-1].type() == CSSToken::Type::Whitespace) {
+        end -= 1;
+    }
+
+    CSSTokenStream value(input.begin(), end);
+    consumeDeclaractionValue(value, properties, id, false);
+}
+
 RefPtr<CSSRule> CSSParser::consumeRule(CSSTokenStream& input)
 {
     if(input->type() == CSSToken::Type::AtKeyword)
@@ -52,14 +69,15 @@ RefPtr<CSSRule> CSSParser::consumeStyleRule(CSSTokenStream& input)
     if(input.empty())
         return nullptr;
 
+    auto blockBegin = input->data().data() + 1;
     auto block = input.consumeBlock();
     CSSSelectorList selectors(m_heap);
     if(!consumeSelectorList(prelude, selectors))
         return nullptr;
 
-    CSSPropertyList properties(m_heap);
-    consumeDeclaractionList(block, properties);
-    return CSSStyleRule::create(m_heap, std::move(selectors), std::move(properties));
+    auto blockEnd = block.end() < input.begin() ? block.end()->data().data() : m_source.end();
+    auto declarations = m_source.substring(blockBegin - m_source.begin(), blockEnd - blockBegin);
+    return CSSStyleRule::create(m_heap, std::move(selectors), declarations);
 }
 
 RefPtr<CSSRule> CSSParser::consumeAtRule(CSSTokenStream& input)
@@ -390,8 +408,8 @@ bool CSSParser::consumeIdSelector(CSSTokenStream& input, CSSCompoundSelector& se
 {
     assert(input->type() == CSSToken::Type::Hash);
     if(input->hashType() == CSSToken::HashType::Identifier) {
-        auto value = HeapString::create(m_heap, input->data());
-        selector.emplace_back(CSSSimpleSelector::MatchType::Id, value);
+        auto name = m_stringPool ? m_stringPool->add(input->data()) : GlobalString(input->data());
+        selector.emplace_back(CSSSimpleSelector::MatchType::Id, name);
         input.consume();
         return true;
     }
@@ -404,8 +422,8 @@ bool CSSParser::consumeClassSelector(CSSTokenStream& input, CSSCompoundSelector&
     assert(input->type() == CSSToken::Type::Delim);
     input.consume();
     if(input->type() == CSSToken::Type::Ident) {
-        auto value = HeapString::create(m_heap, input->data());
-        selector.emplace_back(CSSSimpleSelector::MatchType::Class, value);
+        auto name = m_stringPool ? m_stringPool->add(input->data()) : GlobalString(input->data());
+        selector.emplace_back(CSSSimpleSelector::MatchType::Class, name);
         input.consume();
         return true;
     }
@@ -472,6 +490,10 @@ bool CSSParser::consumeAttributeSelector(CSSTokenStream& input, CSSCompoundSelec
     if(block->type() == CSSToken::Type::Ident && block->data() == "i") {
         caseType = CSSSimpleSelector::AttributeCaseType::InSensitive;
         block.consumeIncludingWhitespace();
+        std::string lowerValue(value);
+        for(auto& cc : lowerValue)
+            cc = tolower(cc);
+        value = HeapString::create(m_heap, lowerValue);
     }
 
     if(block.empty()) {
@@ -541,7 +563,7 @@ bool CSSParser::consumePseudoSelector(CSSTokenStream& input, CSSCompoundSelector
     if(input->type() == CSSToken::Type::Function) {
         auto name = input->data();
         auto block = input.consumeBlock();
-        block.consumeIncludingWhitespace();
+        block.consumeWhitespace();
         static const struct {
             std::string_view name;
             CSSSimpleSelector::MatchType value;
@@ -8,12 +8,15 @@ namespace htmlbook {
 
 class CSSParser {
 public:
-    explicit CSSParser(Heap* heap)
-        : m_heap(heap)
+    explicit CSSParser(Heap* heap, GlobalStringPool* stringPool = nullptr)
+        : m_heap(heap), m_stringPool(stringPool)
     {}
 
     void parseSheet(CSSRuleList& rules, const std::string_view& content);
     void parseStyle(CSSPropertyList& properties, const std::string_view& content);
+    void parseValue(CSSPropertyList& properties, CSSPropertyID id, const std::string_view& content);
+
+    const HeapString& source() const { return m_source; }
 
 private:
     RefPtr<CSSRule> consumeRule(CSSTokenStream& input);
@@ -120,6 +123,8 @@ private:
 
 private:
     Heap* m_heap;
+    HeapString m_source;
+    GlobalStringPool* m_stringPool;
 };
 
 } // namespace htmlbook
@@ -3,6 +3,12 @@
 #include "document.h"
 #include "resource.h"
 #include "boxstyle.h"
+#include "heapresource.h"
+
+#include <mutex>
+#include <limits>
+#include <bit>
+#include <unordered_map>
 
 namespace htmlbook {
 
@@ -10,7 +16,12 @@ RefPtr<CSSInitialValue> CSSInitialValue::create()
 {
     static char buffer[64];
     static Heap heap(buffer, sizeof(buffer));
-    static auto item = create(&heap);
+    static auto item = [] {
+        auto item = create(&heap);
+        item->makeStatic();
+        return item;
+    }();
+
     return item;
 }
 
@@ -23,7 +34,12 @@ RefPtr<CSSInheritValue> CSSInheritValue::create()
 {
     static char buffer[64];
     static Heap heap(buffer, sizeof(buffer));
-    static auto item = create(&heap);
+    static auto item = [] {
+        auto item = create(&heap);
+        item->makeStatic();
+        return item;
+    }();
+
     return item;
 }
 
@@ -34,16 +50,19 @@ RefPtr<CSSInheritValue> CSSInheritValue::create(Heap* heap)
 
 RefPtr<CSSIdentValue> CSSIdentValue::create(CSSValueID value)
 {
+    constexpr auto kNumValueIDs = static_cast<size_t>(CSSValueID::XxxLarge) + 1;
     static Heap heap(1024 * 24);
-    static std::pmr::map<CSSValueID, RefPtr<CSSIdentValue>> table(&heap);
-    auto it = table.find(value);
-    if(it == table.end()) {
-        auto item = create(&heap, value);
-        table.emplace(value, item);
-        return item;
-    }
+    static const auto table = [] {
+        std::array<RefPtr<CSSIdentValue>, kNumValueIDs> table;
+        for(size_t index = 0; index < kNumValueIDs; ++index) {
+            table[index] = create(&heap, static_cast<CSSValueID>(index));
+            table[index]->makeStatic();
+        }
 
-    return it->second;
+        return table;
+    }();
+
+    return table[static_cast<size_t>(value)];
 }
 
 RefPtr<CSSIdentValue> CSSIdentValue::create(Heap* heap, CSSValueID value)
@@ -102,6 +121,8 @@ RefPtr<Image> CSSImageValue::fetch(Document* document) const
         auto imageResource = document->fetchImageResource(m_value);
         if(imageResource == nullptr)
             return nullptr;
+        if(isStatic())
+            return imageResource->image();
         m_image = imageResource->image();
     }
 
@@ -603,9 +624,26 @@ bool CSSSimpleSelector::matchnth(int count) const
     return (b - count) % -a == 0;
 }
 
-RefPtr<CSSStyleRule> CSSStyleRule::create(Heap* heap, CSSSelectorList selectors, CSSPropertyList properties)
+RefPtr<CSSStyleRule> CSSStyleRule::create(Heap* heap, CSSSelectorList selectors, const HeapString& declarations)
 {
-    return adoptPtr(new (heap) CSSStyleRule(std::move(selectors), std::move(properties)));
+    return adoptPtr(new (heap) CSSStyleRule(heap, std::move(selectors), declarations));
+}
+
+static void makeStaticProperties(const CSSPropertyList& properties);
+
+void CSSStyleRule::parseProperties() const
+{
+    static std::mutex mutex;
+    std::unique_lock guard(mutex, std::defer_lock);
+    if(isStatic())
+        guard.lock();
+    if(m_hasParsedProperties.load(std::memory_order_relaxed))
+        return;
+    CSSParser parser(m_heap);
+    parser.parseStyle(m_properties, m_declarations);
+    if(isStatic())
+        makeStaticProperties(m_properties);
+    m_hasParsedProperties.store(true, std::memory_order_release);
 }
 
 RefPtr<CSSImportRule> CSSImportRule::create(Heap* heap, const HeapString& href)
@@ -640,41 +678,218 @@ RefPtr<CSSPageRule> CSSPageRule::create(Heap* heap, CSSPageSelectorList selector
     return adoptPtr(new (heap) CSSPageRule(std::move(selectors), std::move(margins), std::move(properties)));
 }
 
-bool CSSRuleData::match(const Element* element, PseudoType pseudoType) const
+static uint64_t pointerHash(const char* key)
 {
-    auto it = m_selector->rbegin();
-    auto end = m_selector->rend();
-    if(it == end)
-        return false;
+    auto hash = reinterpret_cast<uintptr_t>(key) * 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 32);
+}
 
-    if(!matchCompoundSelector(element, pseudoType, it->compoundSelector()))
-        return false;
+static uint32_t selectorHash(const GlobalString& name, uint32_t salt)
+{
+    auto hash = static_cast<uint32_t>(pointerHash(name.data()) * salt);
+    hash ^= hash >> 16;
+    return hash ? hash : 1;
+}
 
-    auto combinator = it->combinator();
-    ++it;
+uint32_t CSSSelectorFilter::tagHash(const GlobalString& name)
+{
+    return selectorHash(name, 13);
+}
+
+uint32_t CSSSelectorFilter::idHash(const GlobalString& name)
+{
+    return selectorHash(name, 17);
+}
+
+uint32_t CSSSelectorFilter::classHash(const GlobalString& name)
+{
+    return selectorHash(name, 19);
+}
+
+CSSRuleCensus::CSSRuleCensus(const Document* document)
+{
+    addElements(document);
+}
+
+void CSSRuleCensus::addElements(const ContainerNode* node)
+{
+    for(auto child = node->firstChild(); child; child = child->nextSibling()) {
+        if(auto element = to<Element>(child)) {
+            m_tags.insert(element->tagName().data());
+            if(!element->id().empty())
+                m_ids.insert(element->id().data());
+            for(auto& className : element->classNames())
+                m_classes.insert(className.data());
+            for(auto& attribute : element->attributes())
+                m_attributes.insert(attribute.name().data());
+            addElements(element);
+        }
+    }
+}
+
+void CSSSelectorFilter::setParent(const Element* parent)
+{
+    while(!m_parentStack.empty() && m_parentStack.back().element != parent)
+        popParent();
+    if(!m_parentStack.empty() || parent == nullptr)
+        return;
+    std::vector<const Element*> ancestors;
+    for(auto element = parent; element; element = element->parentElement())
+        ancestors.push_back(element);
+    for(auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+        pushParent(*it);
+    }
+}
+
+void CSSSelectorFilter::pushParent(const Element* parent)
+{
+    auto hashCount = m_parentHashes.size();
+    m_parentHashes.push_back(tagHash(parent->tagName()));
+    if(!parent->id().empty())
+        m_parentHashes.push_back(idHash(parent->id()));
+    for(auto& className : parent->classNames())
+        m_parentHashes.push_back(classHash(className));
+    for(auto index = hashCount; index < m_parentHashes.size(); ++index)
+        add(m_parentHashes[index]);
+    m_parentStack.push_back({parent, hashCount});
+}
+
+void CSSSelectorFilter::popParent()
+{
+    auto hashCount = m_parentStack.back().hashCount;
+    for(auto index = hashCount; index < m_parentHashes.size(); ++index)
+        remove(m_parentHashes[index]);
+    m_parentHashes.resize(hashCount);
+    m_parentStack.pop_back();
+}
+
+void CSSSelectorFilter::add(uint32_t hash)
+{
+    increment(m_counts[hash & kKeyMask]);
+    increment(m_counts[(hash >> kKeyBits) & kKeyMask]);
+}
+
+void CSSSelectorFilter::remove(uint32_t hash)
+{
+    decrement(m_counts[hash & kKeyMask]);
+    decrement(m_counts[(hash >> kKeyBits) & kKeyMask]);
+}
+
+void CSSSelectorFilter::increment(uint8_t& count)
+{
+    if(count < std::numeric_limits<uint8_t>::max()) {
+        count += 1;
+    }
+}
 
-    while(it != end) {
-        switch(combinator) {
+void CSSSelectorFilter::decrement(uint8_t& count)
+{
+    assert(count > 0);
+    if(count < std::numeric_limits<uint8_t>::max()) {
+        count -= 1;
+    }
+}
+
+static bool isStructuralSelector(const CSSCompoundSelector& selector)
+{
+    for(auto& sel : selector) {
+        switch(sel.matchType()) {
+        case CSSSimpleSelector::MatchType::PseudoClassEmpty:
+        case CSSSimpleSelector::MatchType::PseudoClassFirstChild:
+        case CSSSimpleSelector::MatchType::PseudoClassLastChild:
+        case CSSSimpleSelector::MatchType::PseudoClassOnlyChild:
+        case CSSSimpleSelector::MatchType::PseudoClassFirstOfType:
+        case CSSSimpleSelector::MatchType::PseudoClassLastOfType:
+        case CSSSimpleSelector::MatchType::PseudoClassOnlyOfType:
+        case CSSSimpleSelector::MatchType::PseudoClassNthChild:
+        case CSSSimpleSelector::MatchType::PseudoClassNthLastChild:
+        case CSSSimpleSelector::MatchType::PseudoClassNthOfType:
+        case CSSSimpleSelector::MatchType::PseudoClassNthLastOfType:
+            return true;
+        case CSSSimpleSelector::MatchType::PseudoClassIs:
+        case CSSSimpleSelector::MatchType::PseudoClassNot:
+            for(auto& subSelector : sel.subSelectors()) {
+                if(isStructuralSelector(subSelector)) {
+                    return true;
+                }
+            }
+
+            break;
+        default:
+            break;
+        }
+    }
+
+    return false;
+}
+
+CSSRuleData::CSSRuleData(const RefPtr<CSSStyleRule>& rule, const CSSSelector* selector, const CSSSimpleSelector* bucketSelector, uint32_t specificity, uint32_t position, uint32_t index)
+    : m_rule(rule), m_selector(selector), m_specificity(specificity), m_position(position), m_index(index)
+{
+    for(auto it = selector->rbegin(); it != selector->rend(); ++it) {
+        if(it->combinator() == CSSComplexSelector::Combinator::DirectAdjacent
+            || it->combinator() == CSSComplexSelector::Combinator::InDirectAdjacent
+            || isStructuralSelector(it->compoundSelector())) {
+            m_hasStructuralSelector = true;
+        }
+
+        compileCompoundSelector(m_instructions, it->compoundSelector(), bucketSelector);
+        switch(it->combinator()) {
+        case CSSComplexSelector::Combinator::None:
+            m_instructions.push_back({Opcode::Match, GlobalString(), nullptr});
+            break;
         case CSSComplexSelector::Combinator::Descendant:
+            m_instructions.push_back({Opcode::Descendant, GlobalString(), nullptr});
+            break;
         case CSSComplexSelector::Combinator::Child:
-            element = element->parentElement();
+            m_instructions.push_back({Opcode::Child, GlobalString(), nullptr});
             break;
         case CSSComplexSelector::Combinator::DirectAdjacent:
+            m_instructions.push_back({Opcode::DirectAdjacent, GlobalString(), nullptr});
+            break;
         case CSSComplexSelector::Combinator::InDirectAdjacent:
-            element = element->previousElement();
+            m_instructions.push_back({Opcode::InDirectAdjacent, GlobalString(), nullptr});
             break;
-        case CSSComplexSelector::Combinator::None:
-            assert(false);
         }
+    }
 
-        if(element == nullptr)
-            return false;
+    size_t count = 0;
+    auto it = selector->rbegin();
+    auto end = selector->rend();
+    if(it == end)
+        return;
+    auto combinator = it->combinator();
+    for(++it; it != end && count < kMaxAncestorHashes; ++it) {
+        if(combinator == CSSComplexSelector::Combinator::Descendant || combinator == CSSComplexSelector::Combinator::Child) {
+            for(auto& sel : it->compoundSelector()) {
+                if(count == kMaxAncestorHashes)
+                    break;
+                switch(sel.matchType()) {
+                case CSSSimpleSelector::MatchType::Tag:
+                    m_ancestorHashes[count++] = CSSSelectorFilter::tagHash(sel.name());
+                    break;
+                case CSSSimpleSelector::MatchType::Id:
+                    m_ancestorHashes[count++] = CSSSelectorFilter::idHash(sel.name());
+                    break;
+                case CSSSimpleSelector::MatchType::Class:
+                    m_ancestorHashes[count++] = CSSSelectorFilter::classHash(sel.name());
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
 
-        if(matchCompoundSelector(element, pseudoType, it->compoundSelector())) {
-            combinator = it->combinator();
-            ++it;
-        } else if(combinator != CSSComplexSelector::Combinator::Descendant
-            && combinator != CSSComplexSelector::Combinator::InDirectAdjacent) {
+        combinator = it->combinator();
+    }
+}
+
+bool CSSRuleData::mayMatch(const CSSSelectorFilter& filter) const
+{
+    for(auto hash : m_ancestorHashes) {
+        if(hash == 0)
+            break;
+        if(!filter.mayContain(hash)) {
             return false;
         }
     }
@@ -682,6 +897,199 @@ bool CSSRuleData::match(const Element* element, PseudoType pseudoType) const
     return true;
 }
 
+bool CSSRuleData::mayMatch(const CSSRuleCensus& census) const
+{
+    for(auto& instruction : m_instructions) {
+        switch(instruction.opcode) {
+        case Opcode::Tag:
+            if(!census.hasTag(instruction.name.data()))
+                return false;
+            break;
+        case Opcode::Id:
+            if(!census.hasId(instruction.name.data()))
+                return false;
+            break;
+        case Opcode::Class:
+            if(!census.hasClass(instruction.name.data()))
+                return false;
+            break;
+        case Opcode::AttributeHas:
+        case Opcode::AttributeEquals:
+        case Opcode::AttributeIncludes:
+        case Opcode::AttributeContains:
+        case Opcode::AttributeDashEquals:
+        case Opcode::AttributeStartsWith:
+        case Opcode::AttributeEndsWith:
+            if(!census.hasAttribute(instruction.name.data()))
+                return false;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool CSSRuleData::match(const Element* element, PseudoType pseudoType) const
+{
+    auto instruction = m_instructions.data();
+    if(!matchInstructions(element, pseudoType, instruction))
+        return false;
+    while(instruction->opcode != Opcode::Match) {
+        auto combinator = instruction->opcode;
+        auto compound = instruction + 1;
+        while(true) {
+            if(combinator == Opcode::Descendant || combinator == Opcode::Child)
+                element = element->parentElement();
+            else
+                element = element->previousElement();
+            if(element == nullptr)
+                return false;
+            instruction = compound;
+            if(matchInstructions(element, pseudoType, instruction))
+                break;
+            if(combinator == Opcode::Child || combinator == Opcode::DirectAdjacent) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool isImpliedByBucket(const CSSSimpleSelector& selector)
+{
+    switch(selector.matchType()) {
+    case CSSSimpleSelector::MatchType::AttributeEquals:
+    case CSSSimpleSelector::MatchType::AttributeIncludes:
+    case CSSSimpleSelector::MatchType::AttributeContains:
+    case CSSSimpleSelector::MatchType::AttributeDashEquals:
+    case CSSSimpleSelector::MatchType::AttributeStartsWith:
+    case CSSSimpleSelector::MatchType::AttributeEndsWith:
+    case CSSSimpleSelector::MatchType::PseudoClassOnlyChild:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void CSSRuleData::compileCompoundSelector(InstructionList& instructions, const CSSCompoundSelector& selector, const CSSSimpleSelector* bucketSelector)
+{
+    for(auto& sel : selector) {
+        if(&sel == bucketSelector && isImpliedByBucket(sel))
+            continue;
+        switch(sel.matchType()) {
+        case CSSSimpleSelector::MatchType::Universal:
+            break;
+        case CSSSimpleSelector::MatchType::Tag:
+            instructions.push_back({Opcode::Tag, sel.name(), nullptr});
+            break;
+        case CSSSimpleSelector::MatchType::Id:
+            instructions.push_back({Opcode::Id, sel.name(), nullptr});
+            break;
+        case CSSSimpleSelector::MatchType::Class:
+            instructions.push_back({Opcode::Class, sel.name(), nullptr});
+            break;
+        case CSSSimpleSelector::MatchType::AttributeHas:
+            instructions.push_back({Opcode::AttributeHas, sel.name(), nullptr});
+            break;
+        case CSSSimpleSelector::MatchType::AttributeEquals:
+            instructions.push_back({Opcode::AttributeEquals, sel.name(), &sel});
+            break;
+        case CSSSimpleSelector::MatchType::AttributeIncludes:
+            instructions.push_back({Opcode::AttributeIncludes, sel.name(), &sel});
+            break;
+        case CSSSimpleSelector::MatchType::AttributeContains:
+            instructions.push_back({Opcode::AttributeContains, sel.name(), &sel});
+            break;
+        case CSSSimpleSelector::MatchType::AttributeDashEquals:
+            instructions.push_back({Opcode::AttributeDashEquals, sel.name(), &sel});
+            break;
+        case CSSSimpleSelector::MatchType::AttributeStartsWith:
+            instructions.push_back({Opcode::AttributeStartsWith, sel.name(), &sel});
+            break;
+        case CSSSimpleSelector::MatchType::AttributeEndsWith:
+            instructions.push_back({Opcode::AttributeEndsWith, sel.name(), &sel});
+            break;
+        default:
+            instructions.push_back({Opcode::Simple, sel.name(), &sel});
+            break;
+        }
+    }
+}
+
+bool CSSRuleData::matchInstructions(const Element* element, PseudoType pseudoType, const Instruction*& instruction)
+{
+    for(; instruction->opcode < Opcode::Descendant; ++instruction) {
+        switch(instruction->opcode) {
+        case Opcode::Tag:
+            if(element->tagName() != instruction->name)
+                return false;
+            break;
+        case Opcode::Id:
+            if(element->id() != instruction->name)
+                return false;
+            break;
+        case Opcode::Class: {
+            auto& classNames = element->classNames();
+            if(std::find(classNames.begin(), classNames.end(), instruction->name) == classNames.end())
+                return false;
+            break;
+        }
+
+        case Opcode::AttributeHas:
+            if(!element->hasAttribute(instruction->name))
+                return false;
+            break;
+        case Opcode::AttributeEquals:
+        case Opcode::AttributeIncludes:
+        case Opcode::AttributeContains:
+        case Opcode::AttributeDashEquals:
+        case Opcode::AttributeStartsWith:
+        case Opcode::AttributeEndsWith:
+            if(!matchAttributeInstruction(element, *instruction))
+                return false;
+            break;
+        case Opcode::Simple:
+            if(!matchSimpleSelector(element, pseudoType, *instruction->selector))
+                return false;
+            break;
+        default:
+            assert(false);
+        }
+    }
+
+    return true;
+}
+
+bool CSSRuleData::matchAttributeInstruction(const Element* element, const Instruction& instruction)
+{
+    auto attribute = element->findAttribute(instruction.name);
+    if(attribute == nullptr)
+        return false;
+    auto& value = instruction.selector->value();
+    auto caseSensitive = instruction.selector->isCaseSensitive();
+    switch(instruction.opcode) {
+    case Opcode::AttributeEquals:
+        return equals(attribute->value(), value, caseSensitive);
+    case Opcode::AttributeIncludes:
+        return includes(attribute->value(), value, caseSensitive);
+    case Opcode::AttributeContains:
+        return contains(attribute->value(), value, caseSensitive);
+    case Opcode::AttributeDashEquals:
+        return dashequals(attribute->value(), value, caseSensitive);
+    case Opcode::AttributeStartsWith:
+        return startswith(attribute->value(), value, caseSensitive);
+    case Opcode::AttributeEndsWith:
+        return endswith(attribute->value(), value, caseSensitive);
+    default:
+        assert(false);
+    }
+
+    return false;
+}
+
 bool CSSRuleData::matchCompoundSelector(const Element* element, PseudoType pseudoType, const CSSCompoundSelector& selector)
 {
     for(auto& sel : selector) {
@@ -696,17 +1104,19 @@ bool CSSRuleData::matchCompoundSelector(const Element* element, PseudoType pseud
 bool CSSRuleData::matchCompoundSelectorList(const Element* element, PseudoType pseudoType, const CSSCompoundSelectorList& selectors)
 {
     for(auto& selector : selectors) {
-        if(!matchCompoundSelector(element, pseudoType, selector)) {
-            return false;
+        if(matchCompoundSelector(element, pseudoType, selector)) {
+            return true;
         }
     }
 
-    return true;
+    return false;
 }
 
 bool CSSRuleData::matchSimpleSelector(const Element* element, PseudoType pseudoType, const CSSSimpleSelector& selector)
 {
     switch(selector.matchType()) {
+    case CSSSimpleSelector::MatchType::Universal:
+        return true;
     case CSSSimpleSelector::MatchType::Tag:
         return matchTagSelector(element, selector);
     case CSSSimpleSelector::MatchType::Id:
@@ -787,13 +1197,13 @@ bool CSSRuleData::matchTagSelector(const Element* element, const CSSSimpleSelect
 
 bool CSSRuleData::matchIdSelector(const Element* element, const CSSSimpleSelector& selector)
 {
-    return element->id() == selector.value();
+    return element->id() == selector.name();
 }
 
 bool CSSRuleData::matchClassSelector(const Element* element, const CSSSimpleSelector& selector)
 {
     for(auto& name : element->classNames()) {
-        if(name == selector.value()) {
+        if(name == selector.name()) {
             return true;
         }
     }
@@ -886,7 +1296,7 @@ bool CSSRuleData::matchPseudoClassCheckedSelector(const Element* element, const
 
 bool CSSRuleData::matchPseudoClassLangSelector(const Element* element, const CSSSimpleSelector& selector)
 {
-    return dashequals(element->lang(), selector.name(), false);
+    return dashequals(element->lang(), selector.value(), false);
 }
 
 bool CSSRuleData::matchPseudoClassRootSelector(const Element* element, const CSSSimpleSelector& selector)
@@ -916,26 +1326,12 @@ bool CSSRuleData::matchPseudoClassOnlyChildSelector(const Element* element, cons
 
 bool CSSRuleData::matchPseudoClassFirstOfTypeSelector(const Element* element, const CSSSimpleSelector& selector)
 {
-    auto child = element->previousElement();
-    while(child) {
-        if(child->tagName() == element->tagName())
-            return false;
-        child = element->previousElement();
-    }
-
-    return true;
+    return element->childIndexOfType() == 1;
 }
 
 bool CSSRuleData::matchPseudoClassLastOfTypeSelector(const Element* element, const CSSSimpleSelector& selector)
 {
-    auto child = element->nextElement();
-    while(child) {
-        if(child->tagName() == element->tagName())
-            return false;
-        child = element->nextElement();
-    }
-
-    return true;
+    return element->childIndexOfTypeFromEnd() == 1;
 }
 
 bool CSSRuleData::matchPseudoClassOnlyOfTypeSelector(const Element* element, const CSSSimpleSelector& selector)
@@ -945,50 +1341,22 @@ bool CSSRuleData::matchPseudoClassOnlyOfTypeSelector(const Element* element, con
 
 bool CSSRuleData::matchPseudoClassNthChildSelector(const Element* element, const CSSSimpleSelector& selector)
 {
-    int count = 1;
-    auto child = element->previousElement();
-    while(child) {
-        count += 1;
-        child = element->previousElement();
-    }
-
-    return selector.matchnth(count);
+    return selector.matchnth(element->childIndex());
 }
 
 bool CSSRuleData::matchPseudoClassNthLastChildSelector(const Element* element, const CSSSimpleSelector& selector)
 {
-    int count = 1;
-    auto child = element->nextElement();
-    while(child) {
-        count += 1;
-        child = element->nextElement();
-    }
-
-    return selector.matchnth(count);
+    return selector.matchnth(element->childIndexFromEnd());
 }
 
 bool CSSRuleData::matchPseudoClassNthOfTypeSelector(const Element* element, const CSSSimpleSelector& selector)
 {
-    int count = 1;
-    auto child = element->previousElement();
-    while(child && child->tagName() == element->tagName()) {
-        count += 1;
-        child = element->previousElement();
-    }
-
-    return selector.matchnth(count);
+    return selector.matchnth(element->childIndexOfType());
 }
 
 bool CSSRuleData::matchPseudoClassNthLastOfTypeSelector(const Element* element, const CSSSimpleSelector& selector)
 {
-    int count = 1;
-    auto child = element->nextElement();
-    while(child && child->tagName() == element->tagName()) {
-        count += 1;
-        child = element->nextElement();
-    }
-
-    return selector.matchnth(count);
+    return selector.matchnth(element->childIndexOfTypeFromEnd());
 }
 
 RefPtr<FontFace> CSSFontFaceCache::get(const std::string_view& family, bool italic, bool smallCaps, int weight) const
@@ -1001,51 +1369,195 @@ void CSSFontFaceCache::add(const HeapString& family, bool italic, bool smallCaps
     m_fontFaceDataMap[family].emplace_back(italic, smallCaps, weight, std::move(face));
 }
 
-static const CSSRuleList& userAgentRules() {
-    static CSSRuleList userAgentRules;
-    return userAgentRules;
+static const char userAgentStyle[] = R"CSS(
+html, address, blockquote, body, center, dialog, div, figure, figcaption,
+footer, form, header, hr, legend, listing, main, p, plaintext, pre, search,
+xmp, article, aside, h1, h2, h3, h4, h5, h6, hgroup, nav, section,
+dir, dd, dl, dt, menu, ol, ul, details, summary, fieldset, optgroup {
+    display: block
 }
 
-CSSStyleSheet::CSSStyleSheet(Document* document)
-    : m_document(document)
+area, base, basefont, datalist, head, link, meta, noembed, noframes,
+param, rp, script, style, template, title {
+    display: none
+}
+
+[hidden] { display: none }
+
+body { margin: 8px }
+
+p, blockquote, figure, listing, plaintext, pre, xmp, dl, dir, menu, ol, ul {
+    margin-top: 1em;
+    margin-bottom: 1em
+}
+
+blockquote, figure { margin-left: 40px; margin-right: 40px }
+dd { margin-left: 40px }
+center { text-align: center }
+
+h1 { font-size: 2em; margin-top: 0.67em; margin-bottom: 0.67em; font-weight: bold }
+h2 { font-size: 1.5em; margin-top: 0.83em; margin-bottom: 0.83em; font-weight: bold }
+h3 { font-size: 1.17em; margin-top: 1em; margin-bottom: 1em; font-weight: bold }
+h4 { font-size: 1em; margin-top: 1.33em; margin-bottom: 1.33em; font-weight: bold }
+h5 { font-size: 0.83em; margin-top: 1.67em; margin-bottom: 1.67em; font-weight: bold }
+h6 { font-size: 0.67em; margin-top: 2.33em; margin-bottom: 2.33em; font-weight: bold }
+
+address, cite, dfn, em, i, var { font-style: italic }
+b, strong, th, dt { font-weight: bold }
+code, kbd, samp, tt, listing, plaintext, pre, xmp { font-family: monospace }
+listing, plaintext, pre, xmp { white-space: pre }
+pre { white-space: pre }
+big { font-size: larger }
+small { font-size: smaller }
+sub { vertical-align: sub; font-size: smaller }
+sup { vertical-align: super; font-size: smaller }
+s, strike, del { text-decoration: line-through }
+u, ins { text-decoration: underline }
+mark { background-color: yellow; color: black }
+abbr[title], acronym[title] { text-decoration: underline }
+nobr { white-space: nowrap }
+br { white-space: pre-line }
+
+a:link { color: #0000ee; text-decoration: underline }
+
+q::before { content: open-quote }
+q::after { content: close-quote }
+
+hr {
+    color: gray;
+    border-style: inset;
+    border-width: 1px;
+    margin-top: 0.5em;
+    margin-bottom: 0.5em;
+    margin-left: auto;
+    margin-right: auto;
+    overflow: hidden
+}
+
+li { display: list-item }
+dir, menu, ol, ul { padding-left: 40px }
+ol { list-style-type: decimal }
+dir, menu, ul { list-style-type: disc }
+ol ul, ul ul, menu ul, dir ul, ol menu, ul menu, menu menu, dir menu, ol dir, ul dir, menu dir, dir dir {
+    list-style-type: circle
+}
+
+ol ol, ol ul, ol menu, ol dir, ul ol, ul ul, ul menu, ul dir,
+menu ol, menu ul, menu menu, menu dir, dir ol, dir ul, dir menu, dir dir {
+    margin-top: 0;
+    margin-bottom: 0
+}
+
+table { display: table; border-spacing: 2px; border-collapse: separate; box-sizing: border-box }
+caption { display: table-caption; text-align: center }
+colgroup { display: table-column-group }
+col { display: table-column }
+thead { display: table-header-group; vertical-align: middle }
+tbody { display: table-row-group; vertical-align: middle }
+tfoot { display: table-footer-group; vertical-align: middle }
+tr { display: table-row; vertical-align: inherit }
+td, th { display: table-cell; vertical-align: inherit; padding: 1px }
+th { text-align: center }
+
+img { display: inline }
+ruby { display: inline }
+rt { font-size: 50% }
+
+fieldset {
+    margin-left: 2px;
+    margin-right: 2px;
+    padding: 0.35em 0.75em 0.625em;
+    border: 2px groove threedface
+}
+
+legend { padding-left: 2px; padding-right: 2px }
+)CSS";
+
+void CSSRuleDataMap::add(const char* key, const CSSRuleData& data)
+{
+    assert(key != nullptr);
+    if(2 * (m_size + 1) > m_entries.size())
+        rehash(std::max<size_t>(16, 2 * m_entries.size()));
+    auto& entry = m_entries[findSlot(key)];
+    if(entry.key == nullptr) {
+        entry.key = key;
+        m_size += 1;
+    }
+
+    entry.rules.push_back(data);
+}
+
+const CSSRuleDataList* CSSRuleDataMap::get(const GlobalString& name) const
 {
-    addRules(userAgentRules());
+    if(m_size == 0 || name.data() == nullptr)
+        return nullptr;
+    auto& entry = m_entries[findSlot(name.data())];
+    if(entry.key == nullptr)
+        return nullptr;
+    return &entry.rules;
 }
 
-RefPtr<BoxStyle> CSSStyleSheet::styleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle) const
+size_t CSSRuleDataMap::findSlot(const char* key) const
 {
-    CSSStyleBuilder builder(element, parentStyle, PseudoType::None);
-    builder.add(m_idRules.get(element->id()));
-    for(auto& className : element->classNames())
-        builder.add(m_classRules.get(className));
-    builder.add(m_tagRules.get(element->tagName()));
-    builder.add(&m_universeRules);
-    return builder.build();
+    auto mask = m_entries.size() - 1;
+    auto index = pointerHash(key) & mask;
+    while(m_entries[index].key && m_entries[index].key != key)
+        index = (index + 1) & mask;
+    return index;
 }
 
-RefPtr<BoxStyle> CSSStyleSheet::pseudoStyleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle, PseudoType pseudoType) const
+void CSSRuleDataMap::rehash(size_t capacity)
 {
-    CSSStyleBuilder builder(element, parentStyle, pseudoType);
-    builder.add(m_pseudoRules.get(pseudoType));
-    return builder.build();
+    auto entries = std::move(m_entries);
+    m_entries = std::vector<Entry>(capacity);
+    for(auto& entry : entries) {
+        if(entry.key) {
+            m_entries[findSlot(entry.key)] = std::move(entry);
+        }
+    }
 }
 
-RefPtr<FontFace> CSSStyleSheet::getFontFace(const std::string_view& family, bool italic, bool smallCaps, int weight) const
+void CSSPseudoRuleSet::add(const CSSSimpleSelector* keySelector, const CSSRuleData& data)
 {
-    if(auto face = m_fontFaceCache.get(family, italic, smallCaps, weight))
-        return face;
-    return resourceLoader()->loadFont(family, italic, smallCaps, weight);
+    m_ruleCount += 1;
+    if(keySelector == nullptr) {
+        m_universeRules.push_back(data);
+        return;
+    }
+
+    switch(keySelector->matchType()) {
+    case CSSSimpleSelector::MatchType::Id:
+        m_idRules.add(keySelector->name(), data);
+        break;
+    case CSSSimpleSelector::MatchType::Class:
+        m_classRules.add(keySelector->name(), data);
+        break;
+    case CSSSimpleSelector::MatchType::Tag:
+        m_tagRules.add(keySelector->name(), data);
+        break;
+    default:
+        assert(false);
+    }
 }
 
-void CSSStyleSheet::parseStyle(const std::string_view& content)
+bool CSSPseudoRuleSet::mayMatch(const Element* element) const
 {
-    CSSRuleList rules(m_document->heap());
-    CSSParser parser(m_document->heap());
-    parser.parseSheet(rules, content);
-    addRules(rules);
+    if(m_ruleCount == 0)
+        return false;
+    if(!m_universeRules.empty() || m_tagRules.get(element->tagName()))
+        return true;
+    if(m_idRules.get(element->id()))
+        return true;
+    for(auto& className : element->classNames()) {
+        if(m_classRules.get(className)) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
-void CSSStyleSheet::addRules(const CSSRuleList& rules)
+void CSSRuleSet::addRules(Document* document, const CSSRuleList& rules)
 {
     for(const auto& rule : rules) {
         if(auto styleRule = to<CSSStyleRule>(rule)) {
@@ -1053,9 +1565,11 @@ void CSSStyleSheet::addRules(const CSSRuleList& rules)
         } else if(auto pageRule = to<CSSPageRule>(rule)) {
             addPageRule(pageRule);
         } else if(auto fontFaceRule = to<CSSFontFaceRule>(rule)) {
-            addFontFaceRule(fontFaceRule);
+            m_fontFaceRules.push_back(fontFaceRule);
         } else if(auto importRule = to<CSSImportRule>(rule)) {
-            addRules(importRule->fetch(m_document));
+            if(document) {
+                addRules(document, importRule->fetch(document));
+            }
         } else {
             assert(false);
         }
@@ -1064,22 +1578,501 @@ void CSSStyleSheet::addRules(const CSSRuleList& rules)
     }
 }
 
-void CSSStyleSheet::addStyleRule(const RefPtr<CSSStyleRule>& rule)
+static void makeStaticValue(const RefPtr<CSSValue>& value)
+{
+    if(value == nullptr || value->isStatic())
+        return;
+    value->makeStatic();
+    if(auto pair = to<CSSPairValue>(value)) {
+        makeStaticValue(pair->first());
+        makeStaticValue(pair->second());
+    } else if(auto rect = to<CSSRectValue>(value)) {
+        makeStaticValue(rect->top());
+        makeStaticValue(rect->right());
+        makeStaticValue(rect->bottom());
+        makeStaticValue(rect->left());
+    } else if(auto list = to<CSSListValue>(value)) {
+        for(auto& item : list->values()) {
+            makeStaticValue(item);
+        }
+    }
+}
+
+static void makeStaticProperties(const CSSPropertyList& properties)
+{
+    for(auto& property : properties) {
+        makeStaticValue(property.value());
+    }
+}
+
+static void makeStaticRuleDataList(const CSSRuleDataList& rules)
+{
+    for(auto& rule : rules) {
+        if(!rule.rule()->isStatic()) {
+            rule.rule()->makeStatic();
+            if(rule.rule()->hasParsedProperties()) {
+                makeStaticProperties(rule.properties());
+            }
+        }
+    }
+}
+
+void CSSRuleSet::makeStatic()
+{
+    forEach(makeStaticRuleDataList);
+    for(auto& rule : m_pageRules) {
+        if(rule.rule()->isStatic())
+            continue;
+        rule.rule()->makeStatic();
+        makeStaticProperties(rule.rule()->properties());
+        for(auto& margin : rule.rule()->margins()) {
+            margin->makeStatic();
+            makeStaticProperties(margin->properties());
+        }
+    }
+
+    for(auto& rule : m_fontFaceRules) {
+        rule->makeStatic();
+        makeStaticProperties(rule->properties());
+    }
+}
+
+CSSRuleMask CSSRuleSet::censusMask(const CSSRuleCensus& census) const
+{
+    CSSRuleMask mask(m_ruleCount);
+    size_t matchCount = 0;
+    forEach([&](const CSSRuleDataList& rules) {
+        for(auto& rule : rules) {
+            if(rule.mayMatch(census)) {
+                mask[rule.index()] = true;
+                matchCount += 1;
+            }
+        }
+    });
+
+    if(matchCount == m_ruleCount)
+        mask.clear();
+    return mask;
+}
+
+static const CSSRuleSet* userAgentRuleSet()
+{
+    static Heap heap(1024 * 96);
+    static const CSSRuleSet ruleSet = [] {
+        CSSRuleList rules(&heap);
+        CSSParser parser(&heap);
+        parser.parseSheet(rules, userAgentStyle);
+
+        CSSRuleSet ruleSet;
+        ruleSet.addRules(nullptr, rules);
+        ruleSet.makeStatic();
+        return ruleSet;
+    }();
+
+    return &ruleSet;
+}
+
+class CSSStyleSheetCache {
+public:
+    static CSSStyleSheetCache* instance();
+
+    std::shared_ptr<const CSSRuleSet> get(const std::string_view& content);
+    void clear();
+
+private:
+    CSSStyleSheetCache() = default;
+
+    struct StyleSheet {
+        explicit StyleSheet(size_t size) : resource(std::pmr::get_default_resource()), heap(size, &resource), stringPool(&heap) {}
+        HeapResource resource;
+        Heap heap;
+        GlobalStringPool stringPool;
+        HeapString source;
+        CSSRuleSet ruleSet;
+    };
+
+    struct Entry {
+        std::shared_ptr<const CSSRuleSet> ruleSet;
+        std::string_view source;
+        size_t size;
+        uint64_t lastUse;
+    };
+
+    using EntryMap = std::unordered_multimap<size_t, Entry>;
+
+    EntryMap::iterator find(size_t hash, const std::string_view& content);
+    void evict(size_t size);
+
+    static std::shared_ptr<const StyleSheet> parse(const std::string_view& content);
+
+    static constexpr size_t kMaxEntries = 64;
+    static constexpr size_t kMaxBytes = 1024 * 1024 * 16;
+    std::mutex m_mutex;
+    EntryMap m_entries;
+    size_t m_totalSize{0};
+    uint64_t m_useCount{0};
+};
+
+CSSStyleSheetCache* CSSStyleSheetCache::instance()
+{
+    static CSSStyleSheetCache cache;
+    return &cache;
+}
+
+std::shared_ptr<const CSSRuleSet> CSSStyleSheetCache::get(const std::string_view& content)
+{
+    auto hash = std::hash<std::string_view>()(content);
+    {
+        std::lock_guard guard(m_mutex);
+        auto it = find(hash, content);
+        if(it != m_entries.end()) {
+            it->second.lastUse = ++m_useCount;
+            return it->second.ruleSet;
+        }
+    }
+
+    auto styleSheet = parse(content);
+    if(styleSheet == nullptr)
+        return nullptr;
+    std::shared_ptr<const CSSRuleSet> ruleSet(styleSheet, &styleSheet->ruleSet);
+    auto size = styleSheet->resource.allocatedBytes();
+    if(size > kMaxBytes)
+        return ruleSet;
+    std::lock_guard guard(m_mutex);
+    auto it = find(hash, content);
+    if(it != m_entries.end()) {
+        it->second.lastUse = ++m_useCount;
+        return it->second.ruleSet;
+    }
+
+    evict(size);
+    m_entries.emplace(hash, Entry{ruleSet, styleSheet->source, size, ++m_useCount});
+    m_totalSize += size;
+    return ruleSet;
+}
+
+void CSSStyleSheetCache::clear()
+{
+    std::lock_guard guard(m_mutex);
+    m_entries.clear();
+    m_totalSize = 0;
+}
+
+CSSStyleSheetCache::EntryMap::iterator CSSStyleSheetCache::find(size_t hash, const std::string_view& content)
+{
+    auto [begin, end] = m_entries.equal_range(hash);
+    for(auto it = begin; it != end; ++it) {
+        if(it->second.source == content) {
+            return it;
+        }
+    }
+
+    return m_entries.end();
+}
+
+void CSSStyleSheetCache::evict(size_t size)
+{
+    while(!m_entries.empty() && (m_entries.size() >= kMaxEntries || m_totalSize + size > kMaxBytes)) {
+        auto oldest = m_entries.begin();
+        for(auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if(it->second.lastUse < oldest->second.lastUse) {
+                oldest = it;
+            }
+        }
+
+        m_totalSize -= oldest->second.size;
+        m_entries.erase(oldest);
+    }
+}
+
+std::shared_ptr<const CSSStyleSheetCache::StyleSheet> CSSStyleSheetCache::parse(const std::string_view& content)
+{
+    auto styleSheet = std::make_shared<StyleSheet>(std::max<size_t>(1024 * 4, content.size() * 2));
+    CSSRuleList rules(&styleSheet->heap);
+    CSSParser parser(&styleSheet->heap, &styleSheet->stringPool);
+    parser.parseSheet(rules, content);
+    for(auto& rule : rules) {
+        if(is<CSSImportRule>(rule)) {
+            return nullptr;
+        }
+    }
+
+    styleSheet->source = parser.source();
+    styleSheet->ruleSet.addRules(nullptr, rules);
+    styleSheet->ruleSet.makeStatic();
+    return styleSheet;
+}
+
+CSSStyleSheet::CSSStyleSheet(Document* document)
+    : m_document(document)
+    , m_userAgentRules(userAgentRuleSet())
+    , m_hasFirstChildRules(!m_userAgentRules->firstChildRules().empty())
+    , m_hasLastChildRules(!m_userAgentRules->lastChildRules().empty())
+{
+}
+
+CSSStyleSheet::~CSSStyleSheet() = default;
+
+RefPtr<BoxStyle> CSSStyleSheet::styleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle)
+{
+    if(m_authorRuleMasks.size() < m_authorRules.size())
+        updateAuthorRuleMasks();
+    m_selectorFilter.setParent(element->parentElement());
+    auto style = findSharedStyle(element, parentStyle);
+    if(style == nullptr) {
+        CSSStyleBuilder builder(element, parentStyle, PseudoType::None, m_selectorFilter);
+        builder.add(*m_userAgentRules, CSSStyleOrigin::UserAgent);
+        for(uint32_t sheet = 0; sheet < m_authorRules.size(); ++sheet)
+            builder.add(*m_authorRules[sheet], CSSStyleOrigin::Author, sheet, &m_authorRuleMasks[sheet]);
+        style = uniqueStyle(builder.build());
+        if(!builder.affectedByStructuralRules()) {
+            addSharedStyle(element, parentStyle, style);
+        }
+    }
+
+    m_styleCount += 1;
+    m_selectorFilter.pushParent(element);
+    return style;
+}
+
+RefPtr<BoxStyle> CSSStyleSheet::pseudoStyleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle, PseudoType pseudoType)
+{
+    if(m_authorRuleMasks.size() < m_authorRules.size())
+        updateAuthorRuleMasks();
+    if(!mayMatchPseudoRules(element, pseudoType)) {
+        if(pseudoType != PseudoType::Marker)
+            return nullptr;
+        m_styleCount += 1;
+        return uniqueStyle(BoxStyle::create(parentStyle, PseudoType::Marker, Display::Inline));
+    }
+
+    m_selectorFilter.setParent(element);
+    CSSStyleBuilder builder(element, parentStyle, pseudoType, m_selectorFilter);
+    builder.add(*m_userAgentRules, CSSStyleOrigin::UserAgent);
+    for(uint32_t sheet = 0; sheet < m_authorRules.size(); ++sheet)
+        builder.add(*m_authorRules[sheet], CSSStyleOrigin::Author, sheet, &m_authorRuleMasks[sheet]);
+    auto style = builder.build();
+    if(style == nullptr)
+        return nullptr;
+    m_styleCount += 1;
+    return uniqueStyle(std::move(style));
+}
+
+bool CSSStyleSheet::mayMatchPseudoRules(const Element* element, PseudoType pseudoType) const
+{
+    if(m_userAgentRules->pseudoRules(pseudoType).mayMatch(element))
+        return true;
+    for(auto& ruleSet : m_authorRules) {
+        if(ruleSet->pseudoRules(pseudoType).mayMatch(element)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CSSStyleSheet::updateAuthorRuleMasks()
+{
+    CSSRuleCensus census(m_document);
+    for(auto index = m_authorRuleMasks.size(); index < m_authorRules.size(); ++index) {
+        m_authorRuleMasks.push_back(m_authorRules[index]->censusMask(census));
+    }
+}
+
+size_t CSSStyleSheet::UniqueStyleHash::operator()(const RefPtr<BoxStyle>& style) const
+{
+    return style->hash();
+}
+
+bool CSSStyleSheet::UniqueStyleEqual::operator()(const RefPtr<BoxStyle>& a, const RefPtr<BoxStyle>& b) const
+{
+    return a->equals(*b);
+}
+
+RefPtr<BoxStyle> CSSStyleSheet::uniqueStyle(RefPtr<BoxStyle> style)
+{
+    return *m_uniqueStyles.insert(std::move(style)).first;
+}
+
+RefPtr<FontFace> CSSStyleSheet::getFontFace(const std::string_view& family, bool italic, bool smallCaps, int weight) const
+{
+    if(auto face = m_fontFaceCache.get(family, italic, smallCaps, weight))
+        return face;
+    return resourceLoader()->loadFont(family, italic, smallCaps, weight);
+}
+
+void CSSStyleSheet::clearCache()
+{
+    CSSStyleSheetCache::instance()->clear();
+}
+
+void CSSStyleSheet::parseStyle(const std::string_view& content)
+{
+    auto ruleSet = CSSStyleSheetCache::instance()->get(content);
+    if(ruleSet == nullptr) {
+        CSSRuleList rules(m_document->heap());
+        CSSParser parser(m_document->heap(), m_document->stringPool());
+        parser.parseSheet(rules, content);
+
+        auto newRuleSet = std::make_shared<CSSRuleSet>();
+        newRuleSet->addRules(m_document, rules);
+        ruleSet = std::move(newRuleSet);
+    }
+
+    for(auto& rule : ruleSet->fontFaceRules())
+        addFontFaceRule(rule);
+    if(!ruleSet->firstChildRules().empty())
+        m_hasFirstChildRules = true;
+    if(!ruleSet->lastChildRules().empty())
+        m_hasLastChildRules = true;
+    m_authorRules.push_back(std::move(ruleSet));
+    m_sharedStyles.clear();
+}
+
+static bool canShareStyle(const Element* element)
+{
+    return element->id().empty() && element->parentElement();
+}
+
+RefPtr<BoxStyle> CSSStyleSheet::findSharedStyle(const Element* element, const RefPtr<BoxStyle>& parentStyle) const
+{
+    if(!canShareStyle(element))
+        return nullptr;
+    if(m_hasFirstChildRules && element->previousElement() == nullptr)
+        return nullptr;
+    if(m_hasLastChildRules && element->nextElement() == nullptr)
+        return nullptr;
+    for(auto& sharedStyle : m_sharedStyles) {
+        auto candidate = sharedStyle.element;
+        if(sharedStyle.parentStyle == parentStyle
+            && candidate->parentElement() == element->parentElement()
+            && candidate->tagName() == element->tagName()
+            && candidate->namespaceUri() == element->namespaceUri()
+            && candidate->attributes() == element->attributes()) {
+            return sharedStyle.style;
+        }
+    }
+
+    return nullptr;
+}
+
+void CSSStyleSheet::addSharedStyle(const Element* element, const RefPtr<BoxStyle>& parentStyle, const RefPtr<BoxStyle>& style)
+{
+    if(!canShareStyle(element))
+        return;
+    if(!m_sharedStyles.empty() && m_sharedStyles.front().element->parentElement() != element->parentElement())
+        m_sharedStyles.clear();
+    if(m_sharedStyles.size() == kMaxSharedStyles)
+        m_sharedStyles.erase(m_sharedStyles.begin());
+    m_sharedStyles.push_back({element, parentStyle, style});
+}
+
+static int bucketRank(const CSSSimpleSelector& selector)
+{
+    switch(selector.matchType()) {
+    case CSSSimpleSelector::MatchType::PseudoElementBefore:
+    case CSSSimpleSelector::MatchType::PseudoElementAfter:
+    case CSSSimpleSelector::MatchType::PseudoElementMarker:
+    case CSSSimpleSelector::MatchType::PseudoElementFirstLetter:
+    case CSSSimpleSelector::MatchType::PseudoElementFirstLine:
+        return 6;
+    case CSSSimpleSelector::MatchType::Id:
+        return 5;
+    case CSSSimpleSelector::MatchType::Class:
+        return 4;
+    case CSSSimpleSelector::MatchType::AttributeHas:
+    case CSSSimpleSelector::MatchType::AttributeEquals:
+    case CSSSimpleSelector::MatchType::AttributeIncludes:
+    case CSSSimpleSelector::MatchType::AttributeContains:
+    case CSSSimpleSelector::MatchType::AttributeDashEquals:
+    case CSSSimpleSelector::MatchType::AttributeStartsWith:
+    case CSSSimpleSelector::MatchType::AttributeEndsWith:
+        return 3;
+    case CSSSimpleSelector::MatchType::Tag:
+        return 2;
+    case CSSSimpleSelector::MatchType::PseudoClassRoot:
+    case CSSSimpleSelector::MatchType::PseudoClassFirstChild:
+    case CSSSimpleSelector::MatchType::PseudoClassLastChild:
+    case CSSSimpleSelector::MatchType::PseudoClassOnlyChild:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static const CSSSimpleSelector* pseudoKeySelector(const CSSCompoundSelector& selector)
+{
+    const CSSSimpleSelector* bestSelector = nullptr;
+    int bestRank = 0;
+    for(auto& sel : selector) {
+        auto rank = bucketRank(sel);
+        if((rank == 5 || rank == 4 || rank == 2) && rank >= bestRank) {
+            bestSelector = &sel;
+            bestRank = rank;
+        }
+    }
+
+    return bestSelector;
+}
+
+static const CSSSimpleSelector* bucketSelector(const CSSCompoundSelector& selector)
+{
+    const CSSSimpleSelector* bestSelector = nullptr;
+    int bestRank = 0;
+    for(auto& sel : selector) {
+        auto rank = bucketRank(sel);
+        if(rank > 0 && rank >= bestRank) {
+            bestSelector = &sel;
+            bestRank = rank;
+        }
+    }
+
+    return bestSelector;
+}
+
+void CSSRuleSet::addStyleRule(const RefPtr<CSSStyleRule>& rule)
 {
     for(auto& selector : rule->selectors()) {
         uint32_t specificity = 0;
-        const CSSSimpleSelector* lastSimpleSelector = nullptr;
         for(auto& complexSelector : selector) {
             for(auto& simpleSelector : complexSelector.compoundSelector()) {
-                lastSimpleSelector = &simpleSelector;
                 switch(simpleSelector.matchType()) {
                 case CSSSimpleSelector::MatchType::Id:
                     specificity += 0x10000;
                     break;
                 case CSSSimpleSelector::MatchType::Class:
+                case CSSSimpleSelector::MatchType::AttributeHas:
+                case CSSSimpleSelector::MatchType::AttributeEquals:
+                case CSSSimpleSelector::MatchType::AttributeIncludes:
+                case CSSSimpleSelector::MatchType::AttributeContains:
+                case CSSSimpleSelector::MatchType::AttributeDashEquals:
+                case CSSSimpleSelector::MatchType::AttributeStartsWith:
+                case CSSSimpleSelector::MatchType::AttributeEndsWith:
+                case CSSSimpleSelector::MatchType::PseudoClassLink:
+                case CSSSimpleSelector::MatchType::PseudoClassEnabled:
+                case CSSSimpleSelector::MatchType::PseudoClassDisabled:
+                case CSSSimpleSelector::MatchType::PseudoClassChecked:
+                case CSSSimpleSelector::MatchType::PseudoClassLang:
+                case CSSSimpleSelector::MatchType::PseudoClassRoot:
+                case CSSSimpleSelector::MatchType::PseudoClassEmpty:
+                case CSSSimpleSelector::MatchType::PseudoClassFirstChild:
+                case CSSSimpleSelector::MatchType::PseudoClassLastChild:
+                case CSSSimpleSelector::MatchType::PseudoClassOnlyChild:
+                case CSSSimpleSelector::MatchType::PseudoClassFirstOfType:
+                case CSSSimpleSelector::MatchType::PseudoClassLastOfType:
+                case CSSSimpleSelector::MatchType::PseudoClassOnlyOfType:
+                case CSSSimpleSelector::MatchType::PseudoClassNthChild:
+                case CSSSimpleSelector::MatchType::PseudoClassNthLastChild:
+                case CSSSimpleSelector::MatchType::PseudoClassNthOfType:
+                case CSSSimpleSelector::MatchType::PseudoClassNthLastOfType:
                     specificity += 0x100;
                     break;
                 case CSSSimpleSelector::MatchType::Tag:
+                case CSSSimpleSelector::MatchType::PseudoElementBefore:
+                case CSSSimpleSelector::MatchType::PseudoElementAfter:
+                case CSSSimpleSelector::MatchType::PseudoElementMarker:
+                case CSSSimpleSelector::MatchType::PseudoElementFirstLetter:
+                case CSSSimpleSelector::MatchType::PseudoElementFirstLine:
                     specificity += 0x1;
                     break;
                 default:
@@ -1088,41 +2081,65 @@ void CSSStyleSheet::addStyleRule(const RefPtr<CSSStyleRule>& rule)
             }
         }
 
-        CSSRuleData ruleData(rule, &selector, specificity, m_position);
-        assert(lastSimpleSelector != nullptr);
-        switch(lastSimpleSelector->matchType()) {
+        auto bucket = bucketSelector(selector.back().compoundSelector());
+        CSSRuleData ruleData(rule, &selector, bucket, specificity, m_position, m_ruleCount);
+        m_ruleCount += 1;
+        if(bucket == nullptr) {
+            m_universeRules.push_back(ruleData);
+            continue;
+        }
+
+        switch(bucket->matchType()) {
         case CSSSimpleSelector::MatchType::Id:
-            m_idRules.add(lastSimpleSelector->value(), ruleData);
+            m_idRules.add(bucket->name(), ruleData);
             break;
         case CSSSimpleSelector::MatchType::Class:
-            m_classRules.add(lastSimpleSelector->value(), ruleData);
+            m_classRules.add(bucket->name(), ruleData);
             break;
         case CSSSimpleSelector::MatchType::Tag:
-            m_tagRules.add(lastSimpleSelector->name(), ruleData);
+            m_tagRules.add(bucket->name(), ruleData);
+            break;
+        case CSSSimpleSelector::MatchType::AttributeHas:
+        case CSSSimpleSelector::MatchType::AttributeEquals:
+        case CSSSimpleSelector::MatchType::AttributeIncludes:
+        case CSSSimpleSelector::MatchType::AttributeContains:
+        case CSSSimpleSelector::MatchType::AttributeDashEquals:
+        case CSSSimpleSelector::MatchType::AttributeStartsWith:
+        case CSSSimpleSelector::MatchType::AttributeEndsWith:
+            m_attributeRules.add(bucket->name(), ruleData);
+            break;
+        case CSSSimpleSelector::MatchType::PseudoClassRoot:
+            m_rootRules.push_back(ruleData);
+            break;
+        case CSSSimpleSelector::MatchType::PseudoClassFirstChild:
+        case CSSSimpleSelector::MatchType::PseudoClassOnlyChild:
+            m_firstChildRules.push_back(ruleData);
+            break;
+        case CSSSimpleSelector::MatchType::PseudoClassLastChild:
+            m_lastChildRules.push_back(ruleData);
             break;
         case CSSSimpleSelector::MatchType::PseudoElementBefore:
-            m_pseudoRules.add(PseudoType::Before, ruleData);
+            m_pseudoRules[static_cast<size_t>(PseudoType::Before)].add(pseudoKeySelector(selector.back().compoundSelector()), ruleData);
             break;
         case CSSSimpleSelector::MatchType::PseudoElementAfter:
-            m_pseudoRules.add(PseudoType::After, ruleData);
+            m_pseudoRules[static_cast<size_t>(PseudoType::After)].add(pseudoKeySelector(selector.back().compoundSelector()), ruleData);
             break;
         case CSSSimpleSelector::MatchType::PseudoElementMarker:
-            m_pseudoRules.add(PseudoType::Marker, ruleData);
+            m_pseudoRules[static_cast<size_t>(PseudoType::Marker)].add(pseudoKeySelector(selector.back().compoundSelector()), ruleData);
             break;
         case CSSSimpleSelector::MatchType::PseudoElementFirstLetter:
-            m_pseudoRules.add(PseudoType::FirstLetter, ruleData);
+            m_pseudoRules[static_cast<size_t>(PseudoType::FirstLetter)].add(pseudoKeySelector(selector.back().compoundSelector()), ruleData);
             break;
         case CSSSimpleSelector::MatchType::PseudoElementFirstLine:
-            m_pseudoRules.add(PseudoType::FirstLine, ruleData);
+            m_pseudoRules[static_cast<size_t>(PseudoType::FirstLine)].add(pseudoKeySelector(selector.back().compoundSelector()), ruleData);
             break;
         default:
-            m_universeRules.push_back(ruleData);
-            break;
+            assert(false);
         }
     }
 }
 
-void CSSStyleSheet::addPageRule(const RefPtr<CSSPageRule>& rule)
+void CSSRuleSet::addPageRule(const RefPtr<CSSPageRule>& rule)
 {
     for(auto& selector : rule->selectors()) {
         uint32_t specificity = 0;
@@ -1260,34 +2277,76 @@ void CSSStyleSheet::addFontFaceRule(const RefPtr<CSSFontFaceRule>& rule)
     }
 }
 
-CSSStyleBuilder::CSSStyleBuilder(Element* element, const RefPtr<BoxStyle>& parentStyle, PseudoType pseudoType)
-    : m_pseudoType(pseudoType), m_element(element), m_parentStyle(parentStyle)
+CSSStyleBuilder::CSSStyleBuilder(Element* element, const RefPtr<BoxStyle>& parentStyle, PseudoType pseudoType, const CSSSelectorFilter& selectorFilter)
+    : m_pseudoType(pseudoType), m_element(element), m_parentStyle(parentStyle), m_selectorFilter(selectorFilter)
 {
 }
 
-void CSSStyleBuilder::add(const CSSRuleDataList* rules)
+void CSSStyleBuilder::add(const CSSRuleSet& ruleSet, CSSStyleOrigin origin, uint32_t sheet, const CSSRuleMask* mask)
+{
+    if(mask && mask->empty())
+        mask = nullptr;
+    if(m_pseudoType != PseudoType::None) {
+        add(ruleSet.pseudoRules(m_pseudoType), origin, sheet, mask);
+        return;
+    }
+
+    add(ruleSet.idRules(m_element->id()), origin, sheet, mask);
+    for(auto& className : m_element->classNames())
+        add(ruleSet.classRules(className), origin, sheet, mask);
+    add(ruleSet.tagRules(m_element->tagName()), origin, sheet, mask);
+    for(auto& attribute : m_element->attributes())
+        add(ruleSet.attributeRules(attribute.name()), origin, sheet, mask);
+    if(m_element->parentElement() == nullptr)
+        add(&ruleSet.rootRules(), origin, sheet, mask);
+    if(m_element->previousElement() == nullptr)
+        add(&ruleSet.firstChildRules(), origin, sheet, mask);
+    if(m_element->nextElement() == nullptr)
+        add(&ruleSet.lastChildRules(), origin, sheet, mask);
+    add(&ruleSet.universeRules(), origin, sheet, mask);
+}
+
+void CSSStyleBuilder::add(const CSSRuleDataList* rules, CSSStyleOrigin origin, uint32_t sheet, const CSSRuleMask* mask)
 {
     if(rules == nullptr)
         return;
     for(auto& rule : *rules) {
+        if(mask && !(*mask)[rule.index()])
+            continue;
+        if(!rule.mayMatch(m_selectorFilter))
+            continue;
+        if(rule.hasStructuralSelector())
+            m_affectedByStructuralRules = true;
         if(!rule.match(m_element, m_pseudoType))
             continue;
-        m_rules.push_back(rule);
+        m_rules.emplace_back(&rule, origin, sheet);
     }
 }
 
+void CSSStyleBuilder::add(const CSSPseudoRuleSet& rules, CSSStyleOrigin origin, uint32_t sheet, const CSSRuleMask* mask)
+{
+    if(rules.ruleCount() == 0)
+        return;
+    add(rules.idRules(m_element->id()), origin, sheet, mask);
+    for(auto& className : m_element->classNames())
+        add(rules.classRules(className), origin, sheet, mask);
+    add(rules.tagRules(m_element->tagName()), origin, sheet, mask);
+    add(&rules.universeRules(), origin, sheet, mask);
+}
+
 void CSSStyleBuilder::add(const CSSPropertyList& properties)
 {
     for(auto& property : properties) {
-        auto it = std::find_if(m_properties.begin(), m_properties.end(), [&](auto& item) { return property.id() == item.id(); });
-        if(it == m_properties.end()) {
-            m_properties.push_back(property);
+        auto index = static_cast<size_t>(property.id());
+        auto word = index / 64;
+        auto bit = uint64_t(1) << (index % 64);
+        if(m_importantBits[word] & bit && !property.important())
             continue;
+        m_values[index] = property.value();
+        m_propertyBits[word] |= bit;
+        if(property.important()) {
+            m_importantBits[word] |= bit;
         }
-
-        if(it->important() && !property.important())
-            continue;
-        *it = property;
     }
 }
 
@@ -1295,15 +2354,15 @@ RefPtr<BoxStyle> CSSStyleBuilder::build()
 {
     std::sort(m_rules.begin(), m_rules.end());
     for(auto& rule : m_rules)
-        add(rule.properties());
+        add(rule.data()->properties());
     if(m_pseudoType == PseudoType::None) {
         add(m_element->inlineStyle());
         add(m_element->presentationAttributeStyle());
     }
 
-    if(m_properties.empty()) {
+    if(std::all_of(m_propertyBits.begin(), m_propertyBits.end(), [](auto bits) { return bits == 0; })) {
         if(m_pseudoType == PseudoType::None) {
-            if(m_parentStyle->isDisplayFlex())
+            if(m_parentStyle->isDisplayFlex() || m_element->isRootNode())
                 return BoxStyle::create(m_parentStyle, Display::Block);
             return BoxStyle::create(m_parentStyle, Display::Inline);
         }
@@ -1313,19 +2372,26 @@ RefPtr<BoxStyle> CSSStyleBuilder::build()
         return nullptr;
     }
 
+    size_t propertyCount = 0;
+    for(auto bits : m_propertyBits)
+        propertyCount += std::popcount(bits);
     auto newStyle = BoxStyle::create(m_element, m_pseudoType, Display::Inline);
     newStyle->inheritFrom(*m_parentStyle);
-    for(auto& property : m_properties) {
-        auto id = property.id();
-        auto value = property.value();
-        if(is<CSSInitialValue>(*value)) {
-            newStyle->remove(id);
-            continue;
-        }
+    newStyle->reserve(propertyCount);
+    for(size_t word = 0; word < kNumCSSPropertyWords; ++word) {
+        for(auto bits = m_propertyBits[word]; bits; bits &= bits - 1) {
+            auto index = word * 64 + std::countr_zero(bits);
+            auto id = static_cast<CSSPropertyID>(index);
+            auto value = std::move(m_values[index]);
+            if(is<CSSInitialValue>(*value)) {
+                newStyle->remove(id);
+                continue;
+            }
 
-        if(is<CSSInheritValue>(*value) && !(value = m_parentStyle->get(id)))
-            continue;
-        newStyle->set(id, std::move(value));
+            if(is<CSSInheritValue>(*value) && !(value = m_parentStyle->get(id)))
+                continue;
+            newStyle->set(id, std::move(value));
+        }
     }
 
     if(m_pseudoType == PseudoType::FirstLetter) {
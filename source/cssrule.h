@@ -5,9 +5,13 @@
 #include "pointer.h"
 
 #include <memory>
+#include <atomic>
 #include <list>
 #include <map>
 #include <set>
+#include <array>
+#include <vector>
+#include <unordered_set>
 
 namespace htmlbook {
 
@@ -829,6 +833,11 @@ enum class CSSPropertyID {
     ZIndex
 };
 
+constexpr size_t kNumCSSPropertyIDs = static_cast<size_t>(CSSPropertyID::ZIndex) + 1;
+constexpr size_t kNumCSSPropertyWords = (kNumCSSPropertyIDs + 63) / 64;
+
+using CSSPropertyBits = std::array<uint64_t, kNumCSSPropertyWords>;
+
 CSSPropertyID csspropertyid(const std::string_view& name);
 
 class CSSProperty {
@@ -1006,21 +1015,35 @@ using CSSRuleList = std::pmr::list<RefPtr<CSSRule>>;
 
 class CSSStyleRule final : public CSSRule {
 public:
-    static RefPtr<CSSStyleRule> create(Heap* heap, CSSSelectorList selectors, CSSPropertyList properties);
+    static RefPtr<CSSStyleRule> create(Heap* heap, CSSSelectorList selectors, const HeapString& declarations);
 
     const CSSSelectorList& selectors() const { return m_selectors; }
-    const CSSPropertyList& properties() const { return m_properties; }
+    const CSSPropertyList& properties() const;
+    const HeapString& declarations() const { return m_declarations; }
+    bool hasParsedProperties() const { return m_hasParsedProperties.load(std::memory_order_acquire); }
     Type type() const final { return Type::Style; }
 
 private:
-    CSSStyleRule(CSSSelectorList selectors, CSSPropertyList properties)
-        : m_selectors(std::move(selectors)), m_properties(std::move(properties))
+    CSSStyleRule(Heap* heap, CSSSelectorList selectors, const HeapString& declarations)
+        : m_selectors(std::move(selectors)), m_declarations(declarations), m_properties(heap), m_heap(heap)
     {}
 
+    void parseProperties() const;
+
     CSSSelectorList m_selectors;
-    CSSPropertyList m_properties;
+    HeapString m_declarations;
+    mutable CSSPropertyList m_properties;
+    mutable std::atomic<bool> m_hasParsedProperties{false};
+    Heap* m_heap;
 };
 
+inline const CSSPropertyList& CSSStyleRule::properties() const
+{
+    if(!hasParsedProperties())
+        parseProperties();
+    return m_properties;
+}
+
 template<>
 struct is_a<CSSStyleRule> {
     static bool check(const CSSRule& value) { return value.type() == CSSRule::Type::Style; }
@@ -1145,23 +1168,110 @@ enum class PseudoType : uint8_t {
     FirstLine
 };
 
+constexpr size_t kNumPseudoTypes = static_cast<size_t>(PseudoType::FirstLine) + 1;
+
 class Element;
+class ContainerNode;
+
+class CSSSelectorFilter {
+public:
+    CSSSelectorFilter() = default;
+
+    void setParent(const Element* parent);
+    void pushParent(const Element* parent);
+    void popParent();
+
+    bool mayContain(uint32_t hash) const { return m_counts[hash & kKeyMask] && m_counts[(hash >> kKeyBits) & kKeyMask]; }
+
+    static uint32_t tagHash(const GlobalString& name);
+    static uint32_t idHash(const GlobalString& name);
+    static uint32_t classHash(const GlobalString& name);
+
+private:
+    void add(uint32_t hash);
+    void remove(uint32_t hash);
+    void increment(uint8_t& count);
+    void decrement(uint8_t& count);
+
+    static constexpr uint32_t kKeyBits = 12;
+    static constexpr uint32_t kKeyMask = (1 << kKeyBits) - 1;
+
+    struct ParentEntry {
+        const Element* element;
+        size_t hashCount;
+    };
+
+    std::vector<ParentEntry> m_parentStack;
+    std::vector<uint32_t> m_parentHashes;
+    std::array<uint8_t, 1 << kKeyBits> m_counts{};
+};
+
+class CSSRuleCensus {
+public:
+    explicit CSSRuleCensus(const Document* document);
+
+    bool hasTag(const char* name) const { return m_tags.contains(name); }
+    bool hasId(const char* name) const { return m_ids.contains(name); }
+    bool hasClass(const char* name) const { return m_classes.contains(name); }
+    bool hasAttribute(const char* name) const { return m_attributes.contains(name); }
+
+private:
+    void addElements(const ContainerNode* node);
+
+    std::unordered_set<const char*> m_tags;
+    std::unordered_set<const char*> m_ids;
+    std::unordered_set<const char*> m_classes;
+    std::unordered_set<const char*> m_attributes;
+};
 
 class CSSRuleData {
 public:
-    CSSRuleData(const RefPtr<CSSStyleRule>& rule, const CSSSelector* selector, uint32_t specificity, uint32_t position)
-        : m_rule(rule), m_selector(selector), m_specificity(specificity), m_position(position)
-    {}
+    CSSRuleData(const RefPtr<CSSStyleRule>& rule, const CSSSelector* selector, const CSSSimpleSelector* bucketSelector, uint32_t specificity, uint32_t position, uint32_t index);
 
     const RefPtr<CSSStyleRule>& rule() const { return m_rule; }
     const CSSSelector* selector() const { return m_selector; }
     const CSSPropertyList& properties() const { return m_rule->properties(); }
     const uint32_t& specificity() const { return m_specificity; }
     const uint32_t& position() const { return m_position; }
+    uint32_t index() const { return m_index; }
+    bool hasStructuralSelector() const { return m_hasStructuralSelector; }
 
+    bool mayMatch(const CSSSelectorFilter& filter) const;
+    bool mayMatch(const CSSRuleCensus& census) const;
     bool match(const Element* element, PseudoType pseudoType) const;
 
 private:
+    enum class Opcode : uint8_t {
+        Tag,
+        Id,
+        Class,
+        AttributeHas,
+        AttributeEquals,
+        AttributeIncludes,
+        AttributeContains,
+        AttributeDashEquals,
+        AttributeStartsWith,
+        AttributeEndsWith,
+        Simple,
+        Descendant,
+        Child,
+        DirectAdjacent,
+        InDirectAdjacent,
+        Match
+    };
+
+    struct Instruction {
+        Opcode opcode;
+        GlobalString name;
+        const CSSSimpleSelector* selector;
+    };
+
+    using InstructionList = std::vector<Instruction>;
+
+    static void compileCompoundSelector(InstructionList& instructions, const CSSCompoundSelector& selector, const CSSSimpleSelector* bucketSelector);
+    static bool matchInstructions(const Element* element, PseudoType pseudoType, const Instruction*& instruction);
+    static bool matchAttributeInstruction(const Element* element, const Instruction& instruction);
+
     static bool matchCompoundSelectorList(const Element* element, PseudoType pseudoType, const CSSCompoundSelectorList& selectors);
     static bool matchCompoundSelector(const Element* element, PseudoType pseudoType, const CSSCompoundSelector& selector);
     static bool matchSimpleSelector(const Element* element, PseudoType pseudoType, const CSSSimpleSelector& selector);
@@ -1205,43 +1315,91 @@ private:
     static bool matchPseudoClassNthLastOfTypeSelector(const Element* element, const CSSSimpleSelector& selector);
 
 private:
+    static constexpr size_t kMaxAncestorHashes = 4;
+
     RefPtr<CSSStyleRule> m_rule;
     const CSSSelector* m_selector;
     uint32_t m_specificity;
     uint32_t m_position;
+    uint32_t m_index;
+    std::array<uint32_t, kMaxAncestorHashes> m_ancestorHashes{};
+    bool m_hasStructuralSelector{false};
+    InstructionList m_instructions;
 };
 
 inline bool operator<(const CSSRuleData& a, const CSSRuleData& b) { return std::tie(a.specificity(), a.position()) < std::tie(b.specificity(), b.position()); }
 inline bool operator>(const CSSRuleData& a, const CSSRuleData& b) { return std::tie(a.specificity(), a.position()) > std::tie(b.specificity(), b.position()); }
 
 using CSSRuleDataList = std::vector<CSSRuleData>;
+using CSSRuleMask = std::vector<bool>;
 
-template<typename T>
 class CSSRuleDataMap {
 public:
     CSSRuleDataMap() = default;
 
-    void add(const T& name, const CSSRuleData& data);
-    const CSSRuleDataList* get(const T& name) const;
+    void add(const GlobalString& name, const CSSRuleData& data) { add(name.data(), data); }
+    void add(const char* key, const CSSRuleData& data);
+    const CSSRuleDataList* get(const GlobalString& name) const;
+
+    template<typename Function>
+    void forEach(Function function) const {
+        for(auto& entry : m_entries) {
+            if(entry.key) {
+                function(entry.rules);
+            }
+        }
+    }
+
+    template<typename Function>
+    void forEachKey(Function function) const {
+        for(auto& entry : m_entries) {
+            if(entry.key) {
+                function(entry.key, entry.rules);
+            }
+        }
+    }
 
 private:
-    std::map<T, CSSRuleDataList> m_ruleDataMap;
+    struct Entry {
+        const char* key{nullptr};
+        CSSRuleDataList rules;
+    };
+
+    size_t findSlot(const char* key) const;
+    void rehash(size_t capacity);
+
+    std::vector<Entry> m_entries;
+    size_t m_size{0};
 };
 
-template<typename T>
-void CSSRuleDataMap<T>::add(const T& name, const CSSRuleData& data)
-{
-    m_ruleDataMap[name].push_back(data);
-}
+class CSSPseudoRuleSet {
+public:
+    CSSPseudoRuleSet() = default;
 
-template<typename T>
-const CSSRuleDataList* CSSRuleDataMap<T>::get(const T& name) const
-{
-    auto it = m_ruleDataMap.find(name);
-    if(it == m_ruleDataMap.end())
-        return nullptr;
-    return &it->second;
-}
+    void add(const CSSSimpleSelector* keySelector, const CSSRuleData& data);
+    bool mayMatch(const Element* element) const;
+
+    const CSSRuleDataList* idRules(const GlobalString& name) const { return m_idRules.get(name); }
+    const CSSRuleDataList* classRules(const GlobalString& name) const { return m_classRules.get(name); }
+    const CSSRuleDataList* tagRules(const GlobalString& name) const { return m_tagRules.get(name); }
+    const CSSRuleDataList& universeRules() const { return m_universeRules; }
+    size_t ruleCount() const { return m_ruleCount; }
+
+    template<typename Function>
+    void forEach(Function function) const {
+        m_idRules.forEach(function);
+        m_classRules.forEach(function);
+        m_tagRules.forEach(function);
+        function(m_universeRules);
+    }
+
+private:
+    CSSRuleDataMap m_idRules;
+    CSSRuleDataMap m_classRules;
+    CSSRuleDataMap m_tagRules;
+    CSSRuleDataList m_universeRules;
+    size_t m_ruleCount{0};
+};
 
 class CSSPageRuleData {
 public:
@@ -1285,50 +1443,166 @@ private:
 
 class BoxStyle;
 
+using CSSFontFaceRuleList = std::vector<RefPtr<CSSFontFaceRule>>;
+
+class CSSRuleSet {
+public:
+    CSSRuleSet() = default;
+
+    void addRules(Document* document, const CSSRuleList& rules);
+    void makeStatic();
+    CSSRuleMask censusMask(const CSSRuleCensus& census) const;
+
+    const CSSRuleDataList* idRules(const GlobalString& name) const { return m_idRules.get(name); }
+    const CSSRuleDataList* classRules(const GlobalString& name) const { return m_classRules.get(name); }
+    const CSSRuleDataList* tagRules(const GlobalString& name) const { return m_tagRules.get(name); }
+    const CSSRuleDataList* attributeRules(const GlobalString& name) const { return m_attributeRules.get(name); }
+    const CSSPseudoRuleSet& pseudoRules(PseudoType pseudoType) const { return m_pseudoRules[static_cast<size_t>(pseudoType)]; }
+    const CSSRuleDataList& rootRules() const { return m_rootRules; }
+    const CSSRuleDataList& firstChildRules() const { return m_firstChildRules; }
+    const CSSRuleDataList& lastChildRules() const { return m_lastChildRules; }
+    const CSSRuleDataList& universeRules() const { return m_universeRules; }
+    const CSSPageRuleDataList& pageRules() const { return m_pageRules; }
+    const CSSFontFaceRuleList& fontFaceRules() const { return m_fontFaceRules; }
+    size_t ruleCount() const { return m_ruleCount; }
+
+    template<typename Function>
+    void forEach(Function function) const {
+        m_idRules.forEach(function);
+        m_classRules.forEach(function);
+        m_tagRules.forEach(function);
+        m_attributeRules.forEach(function);
+        for(auto& rules : m_pseudoRules)
+            rules.forEach(function);
+        function(m_rootRules);
+        function(m_firstChildRules);
+        function(m_lastChildRules);
+        function(m_universeRules);
+    }
+
+private:
+    void addStyleRule(const RefPtr<CSSStyleRule>& rule);
+    void addPageRule(const RefPtr<CSSPageRule>& rule);
+
+    CSSRuleDataMap m_idRules;
+    CSSRuleDataMap m_classRules;
+    CSSRuleDataMap m_tagRules;
+    CSSRuleDataMap m_attributeRules;
+    std::array<CSSPseudoRuleSet, kNumPseudoTypes> m_pseudoRules;
+
+    CSSRuleDataList m_rootRules;
+    CSSRuleDataList m_firstChildRules;
+    CSSRuleDataList m_lastChildRules;
+    CSSRuleDataList m_universeRules;
+    CSSPageRuleDataList m_pageRules;
+    CSSFontFaceRuleList m_fontFaceRules;
+
+    uint32_t m_position{0};
+    size_t m_ruleCount{0};
+};
+
 class CSSStyleSheet {
 public:
     explicit CSSStyleSheet(Document* document);
+    ~CSSStyleSheet();
 
-    RefPtr<BoxStyle> styleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle) const;
-    RefPtr<BoxStyle> pseudoStyleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle, PseudoType pseudoType) const;
+    RefPtr<BoxStyle> styleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle);
+    RefPtr<BoxStyle> pseudoStyleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle, PseudoType pseudoType);
     RefPtr<FontFace> getFontFace(const std::string_view& family, bool italic, bool smallCaps, int weight) const;
 
     void parseStyle(const std::string_view& content);
 
+    static void clearCache();
+
+    size_t styleCount() const { return m_styleCount; }
+    size_t uniqueStyleCount() const { return m_uniqueStyles.size(); }
+
 private:
-    void addRules(const CSSRuleList& rules);
-    void addStyleRule(const RefPtr<CSSStyleRule>& rule);
-    void addPageRule(const RefPtr<CSSPageRule>& rule);
     void addFontFaceRule(const RefPtr<CSSFontFaceRule>& rule);
+    RefPtr<BoxStyle> uniqueStyle(RefPtr<BoxStyle> style);
+    bool mayMatchPseudoRules(const Element* element, PseudoType pseudoType) const;
+    void updateAuthorRuleMasks();
 
-    Document* m_document;
-    CSSRuleDataMap<HeapString> m_idRules;
-    CSSRuleDataMap<HeapString> m_classRules;
-    CSSRuleDataMap<GlobalString> m_tagRules;
-    CSSRuleDataMap<PseudoType> m_pseudoRules;
+    RefPtr<BoxStyle> findSharedStyle(const Element* element, const RefPtr<BoxStyle>& parentStyle) const;
+    void addSharedStyle(const Element* element, const RefPtr<BoxStyle>& parentStyle, const RefPtr<BoxStyle>& style);
 
-    CSSRuleDataList m_universeRules;
-    CSSPageRuleDataList m_pageRules;
+    struct SharedStyle {
+        const Element* element;
+        RefPtr<BoxStyle> parentStyle;
+        RefPtr<BoxStyle> style;
+    };
+
+    struct UniqueStyleHash {
+        size_t operator()(const RefPtr<BoxStyle>& style) const;
+    };
+
+    struct UniqueStyleEqual {
+        bool operator()(const RefPtr<BoxStyle>& a, const RefPtr<BoxStyle>& b) const;
+    };
+
+    static constexpr size_t kMaxSharedStyles = 8;
+
+    Document* m_document;
+    const CSSRuleSet* m_userAgentRules;
+    std::vector<std::shared_ptr<const CSSRuleSet>> m_authorRules;
+    std::vector<CSSRuleMask> m_authorRuleMasks;
     CSSFontFaceCache m_fontFaceCache;
+    CSSSelectorFilter m_selectorFilter;
+    std::vector<SharedStyle> m_sharedStyles;
+    std::unordered_set<RefPtr<BoxStyle>, UniqueStyleHash, UniqueStyleEqual> m_uniqueStyles;
+    size_t m_styleCount{0};
+    bool m_hasFirstChildRules;
+    bool m_hasLastChildRules;
+};
 
-    uint32_t m_position{0};
+enum class CSSStyleOrigin : uint8_t {
+    UserAgent,
+    Author
 };
 
+class CSSMatchedRule {
+public:
+    CSSMatchedRule(const CSSRuleData* data, CSSStyleOrigin origin, uint32_t sheet)
+        : m_data(data), m_origin(origin), m_sheet(sheet)
+    {}
+
+    const CSSRuleData* data() const { return m_data; }
+    const CSSStyleOrigin& origin() const { return m_origin; }
+    const uint32_t& sheet() const { return m_sheet; }
+
+private:
+    const CSSRuleData* m_data;
+    CSSStyleOrigin m_origin;
+    uint32_t m_sheet;
+};
+
+inline bool operator<(const CSSMatchedRule& a, const CSSMatchedRule& b)
+{
+    return std::tie(a.origin(), a.data()->specificity(), a.sheet(), a.data()->position()) < std::tie(b.origin(), b.data()->specificity(), b.sheet(), b.data()->position());
+}
+
 class CSSStyleBuilder {
 public:
-    CSSStyleBuilder(Element* element, const RefPtr<BoxStyle>& parentStyle, PseudoType pseudoType);
+    CSSStyleBuilder(Element* element, const RefPtr<BoxStyle>& parentStyle, PseudoType pseudoType, const CSSSelectorFilter& selectorFilter);
 
-    void add(const CSSRuleDataList* rules);
+    void add(const CSSRuleSet& ruleSet, CSSStyleOrigin origin, uint32_t sheet = 0, const CSSRuleMask* mask = nullptr);
+    void add(const CSSRuleDataList* rules, CSSStyleOrigin origin, uint32_t sheet, const CSSRuleMask* mask);
+    void add(const CSSPseudoRuleSet& rules, CSSStyleOrigin origin, uint32_t sheet, const CSSRuleMask* mask);
     void add(const CSSPropertyList& properties);
 
     RefPtr<BoxStyle> build();
+    bool affectedByStructuralRules() const { return m_affectedByStructuralRules; }
 
 private:
     PseudoType m_pseudoType;
     Element* m_element;
     RefPtr<BoxStyle> m_parentStyle;
-    CSSPropertyList m_properties;
-    CSSRuleDataList m_rules;
+    const CSSSelectorFilter& m_selectorFilter;
+    std::array<RefPtr<CSSValue>, kNumCSSPropertyIDs> m_values;
+    CSSPropertyBits m_propertyBits{};
+    CSSPropertyBits m_importantBits{};
+    std::vector<CSSMatchedRule> m_rules;
+    bool m_affectedByStructuralRules{false};
 };
 
 } // namespace htmlbook
@@ -569,9 +569,9 @@ CSSToken CSSTokenizer::nextToken()
     case ']':
         return CSSToken(CSSToken::Type::RightSquareBracket);
     case '{':
-        return CSSToken(CSSToken::Type::LeftCurlyBracket);
+        return CSSToken(CSSToken::Type::LeftCurlyBracket, substring(m_input.offset() - 1, 1));
     case '}':
-        return CSSToken(CSSToken::Type::RightCurlyBracket);
+        return CSSToken(CSSToken::Type::RightCurlyBracket, substring(m_input.offset() - 1, 1));
     case ',':
         return CSSToken(CSSToken::Type::Comma);
     case ':':
@@ -6,6 +6,8 @@
 #include "textbox.h"
 #include "boxview.h"
 
+#include <unordered_map>
+
 namespace htmlbook {
 
 Node::Node(Document* document)
@@ -85,15 +87,7 @@ ContainerNode::ContainerNode(Document* document)
 
 ContainerNode::~ContainerNode()
 {
-    auto child = m_firstChild;
-    while(child) {
-        Node* next = child->nextSibling();
-        child->setParentNode(nullptr);
-        child->setPreviousSibling(nullptr);
-        child->setNextSibling(nullptr);
-        delete child;
-        child = next;
-    }
+    removeChildren();
 }
 
 void ContainerNode::appendChild(Node* child)
@@ -102,6 +96,7 @@ void ContainerNode::appendChild(Node* child)
     assert(child->previousSibling() == nullptr);
     assert(child->nextSibling() == nullptr);
     child->setParentNode(this);
+    m_hasChildIndices = false;
     if(m_firstChild == nullptr) {
         m_firstChild = m_lastChild = child;
         return;
@@ -138,6 +133,7 @@ void ContainerNode::insertChild(Node* child, Node* nextChild)
     child->setParentNode(this);
     child->setPreviousSibling(previousChild);
     child->setNextSibling(nextChild);
+    m_hasChildIndices = false;
 }
 
 void ContainerNode::removeChild(Node* child)
@@ -158,6 +154,23 @@ void ContainerNode::removeChild(Node* child)
     child->setParentNode(nullptr);
     child->setPreviousSibling(nullptr);
     child->setNextSibling(nullptr);
+    m_hasChildIndices = false;
+}
+
+void ContainerNode::removeChildren()
+{
+    auto child = m_firstChild;
+    while(child) {
+        Node* next = child->nextSibling();
+        child->setParentNode(nullptr);
+        child->setPreviousSibling(nullptr);
+        child->setNextSibling(nullptr);
+        delete child;
+        child = next;
+    }
+
+    m_firstChild = nullptr;
+    m_lastChild = nullptr;
 }
 
 void ContainerNode::reparentChildren(ContainerNode* newParent)
@@ -167,6 +180,29 @@ void ContainerNode::reparentChildren(ContainerNode* newParent)
     }
 }
 
+void ContainerNode::updateChildIndices() const
+{
+    if(m_hasChildIndices)
+        return;
+    uint32_t count = 0;
+    std::unordered_map<const char*, uint32_t> typeCounts;
+    for(auto child = m_firstChild; child; child = child->nextSibling()) {
+        if(auto element = to<Element>(child)) {
+            element->m_childIndex = ++count;
+            element->m_childIndexOfType = ++typeCounts[element->tagName().data()];
+        }
+    }
+
+    for(auto child = m_firstChild; child; child = child->nextSibling()) {
+        if(auto element = to<Element>(child)) {
+            element->m_childIndexFromEnd = count - element->m_childIndex + 1;
+            element->m_childIndexOfTypeFromEnd = typeCounts[element->tagName().data()] - element->m_childIndexOfType + 1;
+        }
+    }
+
+    m_hasChildIndices = true;
+}
+
 void ContainerNode::buildBox(Counters& counters, Box* parent)
 {
     auto child = m_firstChild;
@@ -273,7 +309,7 @@ void Element::removeAttribute(const GlobalString& name)
 void Element::parseAttribute(const GlobalString& name, const HeapString& value)
 {
     if(name == idAttr) {
-        m_id = value;
+        m_id = document()->stringPool()->add(value);
     } else if(name == classAttr) {
         m_classNames.clear();
         if(value.empty())
@@ -287,38 +323,31 @@ void Element::parseAttribute(const GlobalString& name, const HeapString& value)
             size_t end = begin + 1;
             while(end < value.length() && !isspace(value[end]))
                 ++end;
-            m_classNames.push_back(value.substring(begin, end - begin));
+            m_classNames.push_back(document()->stringPool()->add(value.substring(begin, end - begin)));
             begin = end + 1;
         }
     }
 }
 
-CSSPropertyList Element::inlineStyle() const
+const CSSPropertyList& Element::inlineStyle() const
 {
-    auto value = getAttribute(styleAttr);
-    if(value.empty())
-        return CSSPropertyList{};
-
-    CSSPropertyList properties(heap());
-    CSSParser parser(heap());
-    parser.parseStyle(properties, value);
-    return properties;
+    return document()->inlineStyle(getAttribute(styleAttr));
 }
 
 CSSPropertyList Element::presentationAttributeStyle() const
 {
-    std::stringstream output;
-    for(auto& attribute : attributes()) {
-        collectAttributeStyle(output, attribute.name(), attribute.value());
-        output << ';';
-    }
-
     CSSPropertyList properties(heap());
-    CSSParser parser(heap());
-    parser.parseStyle(properties, output.str());
+    for(auto& attribute : attributes())
+        collectAttributeStyle(properties, attribute.name(), attribute.value());
     return properties;
 }
 
+void Element::addAttributeStyle(CSSPropertyList& properties, CSSPropertyID id, const HeapString& value) const
+{
+    auto& style = document()->attributeStyle(id, value);
+    properties.insert(properties.end(), style.begin(), style.end());
+}
+
 Element* Element::parentElement() const
 {
     return to<Element>(parentNode());
@@ -348,6 +377,34 @@ Element* Element::nextElement() const
     return nullptr;
 }
 
+uint32_t Element::childIndex() const
+{
+    if(auto parent = parentNode())
+        parent->updateChildIndices();
+    return m_childIndex;
+}
+
+uint32_t Element::childIndexFromEnd() const
+{
+    if(auto parent = parentNode())
+        parent->updateChildIndices();
+    return m_childIndexFromEnd;
+}
+
+uint32_t Element::childIndexOfType() const
+{
+    if(auto parent = parentNode())
+        parent->updateChildIndices();
+    return m_childIndexOfType;
+}
+
+uint32_t Element::childIndexOfTypeFromEnd() const
+{
+    if(auto parent = parentNode())
+        parent->updateChildIndices();
+    return m_childIndexOfTypeFromEnd;
+}
+
 void Element::serialize(std::ostream& o) const
 {
     o << '<';
@@ -378,11 +435,22 @@ Document::Document(Heap* heap)
     : ContainerNode(this)
     , m_heap(heap)
     , m_idCache(heap)
+    , m_stringPool(heap)
     , m_resourceCache(heap)
+    , m_inlineStyleCache(heap)
+    , m_attributeStyleCache(heap)
     , m_styleSheet(this)
 {
 }
 
+Document::~Document()
+{
+    removeChildren();
+    delete box();
+    setBox(nullptr);
+    m_rootElement = nullptr;
+}
+
 TextNode* Document::createTextNode(const std::string_view& value)
 {
     return new (m_heap) TextNode(this, HeapString::create(m_heap, value));
@@ -445,6 +513,32 @@ RefPtr<FontFace> Document::getFontFace(const std::string_view& family, bool ital
     return m_styleSheet.getFontFace(family, italic, smallCaps, weight);
 }
 
+const CSSPropertyList& Document::inlineStyle(const HeapString& value)
+{
+    auto [it, inserted] = m_inlineStyleCache.try_emplace(value);
+    if(inserted && !value.empty()) {
+        CSSParser parser(m_heap);
+        parser.parseStyle(it->second, value);
+    }
+
+    return it->second;
+}
+
+const CSSPropertyList& Document::attributeStyle(CSSPropertyID id, const HeapString& value)
+{
+    auto [it, inserted] = m_attributeStyleCache.try_emplace(std::make_pair(id, value));
+    if(inserted) {
+        if(id == CSSPropertyID::BackgroundImage) {
+            it->second.emplace_back(id, false, CSSImageValue::create(m_heap, value));
+        } else {
+            CSSParser parser(m_heap);
+            parser.parseValue(it->second, id, value);
+        }
+    }
+
+    return it->second;
+}
+
 RefPtr<TextResource> Document::fetchTextResource(const std::string_view& url)
 {
     return fetchResource<TextResource>(url);
@@ -494,6 +588,16 @@ void Document::build()
     buildBox(counters, nullptr);
 }
 
+BoxView* Document::layout()
+{
+    if(auto view = to<BoxView>(box()))
+        return view;
+    build();
+    auto view = to<BoxView>(box());
+    view->layout();
+    return view;
+}
+
 template<typename ResourceType>
 RefPtr<ResourceType> Document::fetchResource(const std::string_view& url)
 {
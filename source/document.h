@@ -14,6 +14,7 @@ class Document;
 class Box;
 class BoxStyle;
 class Counters;
+class BoxView;
 
 class Node : public HeapMember {
 public:
@@ -101,7 +102,9 @@ public:
     void appendChild(Node* child);
     void insertChild(Node* child, Node* nextChild);
     void removeChild(Node* child);
+    void removeChildren();
     void reparentChildren(ContainerNode* newParent);
+    void updateChildIndices() const;
 
     void buildBox(Counters& counters, Box* parent) override;
     void serialize(std::ostream& o) const override;
@@ -109,6 +112,7 @@ public:
 private:
     Node* m_firstChild{nullptr};
     Node* m_lastChild{nullptr};
+    mutable bool m_hasChildIndices{false};
 };
 
 template<>
@@ -140,7 +144,7 @@ inline bool operator==(const Attribute& a, const Attribute& b) { return a.name()
 inline bool operator!=(const Attribute& a, const Attribute& b) { return a.name() != b.name() || a.value() != b.value(); }
 
 using AttributeList = std::pmr::list<Attribute>;
-using ClassNameList = std::pmr::list<HeapString>;
+using ClassNameList = std::pmr::list<GlobalString>;
 
 class Element : public ContainerNode {
 public:
@@ -153,7 +157,7 @@ public:
     const AttributeList& attributes() const { return m_attributes; }
 
     const HeapString& lang() const;
-    const HeapString& id() const { return m_id; }
+    const GlobalString& id() const { return m_id; }
     const ClassNameList& classNames() const { return m_classNames; }
 
     const Attribute* findAttribute(const GlobalString& name) const;
@@ -164,23 +168,36 @@ public:
     void setAttribute(const GlobalString& name, const HeapString& value);
     void removeAttribute(const GlobalString& name);
     virtual void parseAttribute(const GlobalString& name, const HeapString& value);
-    virtual void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const {}
+    virtual void collectAttributeStyle(CSSPropertyList&, const GlobalString&, const HeapString&) const {}
 
-    CSSPropertyList inlineStyle() const;
+    const CSSPropertyList& inlineStyle() const;
     CSSPropertyList presentationAttributeStyle() const;
 
     Element* parentElement() const;
     Element* previousElement() const;
     Element* nextElement() const;
 
+    uint32_t childIndex() const;
+    uint32_t childIndexFromEnd() const;
+    uint32_t childIndexOfType() const;
+    uint32_t childIndexOfTypeFromEnd() const;
+
     void serialize(std::ostream& o) const override;
 
+protected:
+    void addAttributeStyle(CSSPropertyList& properties, CSSPropertyID id, const HeapString& value) const;
+
 private:
+    friend class ContainerNode;
     GlobalString m_tagName;
     GlobalString m_namespaceUri;
-    HeapString m_id;
+    GlobalString m_id;
     ClassNameList m_classNames;
     AttributeList m_attributes;
+    mutable uint32_t m_childIndex{1};
+    mutable uint32_t m_childIndexFromEnd{1};
+    mutable uint32_t m_childIndexOfType{1};
+    mutable uint32_t m_childIndexOfTypeFromEnd{1};
 };
 
 template<>
@@ -211,6 +228,7 @@ class FontFace;
 class Document : public ContainerNode {
 public:
     Document(Heap* heap);
+    ~Document() override;
 
     bool isDocumentNode() const final { return true; }
 
@@ -218,6 +236,8 @@ public:
     TextNode* createTextNode(const std::string_view& value);
     Element* createElement(const GlobalString& tagName, const GlobalString& namespaceUri);
 
+    GlobalStringPool* stringPool() { return &m_stringPool; }
+
     const Url& baseUrl() const { return m_baseUrl; }
     void setBaseUrl(Url value) { m_baseUrl = std::move(value); }
 
@@ -228,6 +248,8 @@ public:
     RefPtr<BoxStyle> styleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle);
     RefPtr<BoxStyle> pseudoStyleForElement(Element* element, const RefPtr<BoxStyle>& parentStyle, PseudoType pseudoType);
     RefPtr<FontFace> getFontFace(const std::string_view& family, bool italic, bool smallCaps, int weight);
+    const CSSPropertyList& inlineStyle(const HeapString& value);
+    const CSSPropertyList& attributeStyle(CSSPropertyID id, const HeapString& value);
 
     RefPtr<TextResource> fetchTextResource(const std::string_view& url);
     RefPtr<ImageResource> fetchImageResource(const std::string_view& url);
@@ -245,6 +267,7 @@ public:
     Box* createBox(const RefPtr<BoxStyle>& style) override;
     void buildBox(Counters& counters, Box* parent) override;
     void build();
+    BoxView* layout();
 
 private:
     template<typename ResourceType>
@@ -253,7 +276,10 @@ private:
     Url m_baseUrl;
     Heap* m_heap;
     std::pmr::map<HeapString, Element*> m_idCache;
+    GlobalStringPool m_stringPool;
     std::pmr::map<Url, RefPtr<Resource>> m_resourceCache;
+    std::pmr::map<HeapString, CSSPropertyList> m_inlineStyleCache;
+    std::pmr::map<std::pair<CSSPropertyID, HeapString>, CSSPropertyList> m_attributeStyleCache;
     CSSStyleSheet m_styleSheet;
 };
 
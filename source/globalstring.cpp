@@ -1,9 +1,686 @@
 #include "globalstring.h"
 
-#include <set>
+#include <array>
+#include <unordered_map>
+#include <cstring>
+#include <memory>
+#include <atomic>
+#include <cassert>
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
 
 namespace htmlbook {
 
+namespace {
+
+constexpr std::string_view predeclaredNames[] = {
+    "",
+    "*",
+    "http://www.w3.org/1999/xhtml",
+    "http://www.w3.org/1998/Math/MathML",
+    "http://www.w3.org/2000/svg",
+    "altGlyph",
+    "altGlyphDef",
+    "altGlyphItem",
+    "animateColor",
+    "animateMotion",
+    "animateTransform",
+    "feBlend",
+    "feColorMatrix",
+    "feComponentTransfer",
+    "feComposite",
+    "feConvolveMatrix",
+    "feDiffuseLighting",
+    "feDisplacementMap",
+    "feDistantLight",
+    "feDropShadow",
+    "feFlood",
+    "feFuncA",
+    "feFuncB",
+    "feFuncG",
+    "feFuncR",
+    "feGaussianBlur",
+    "feImage",
+    "feMerge",
+    "feMergeNode",
+    "feMorphology",
+    "feOffset",
+    "fePointLight",
+    "feSpecularLighting",
+    "feSpotLight",
+    "glyphRef",
+    "definitionUrl",
+    "a",
+    "abbr",
+    "acronym",
+    "address",
+    "applet",
+    "area",
+    "article",
+    "aside",
+    "audio",
+    "b",
+    "base",
+    "basefont",
+    "bgsound",
+    "big",
+    "blockquote",
+    "body",
+    "br",
+    "button",
+    "canvas",
+    "caption",
+    "center",
+    "cite",
+    "code",
+    "col",
+    "colgroup",
+    "command",
+    "datagrid",
+    "datalist",
+    "dcell",
+    "dcol",
+    "dd",
+    "details",
+    "del",
+    "dfn",
+    "dir",
+    "div",
+    "dl",
+    "drow",
+    "dt",
+    "em",
+    "embed",
+    "fieldset",
+    "figcaption",
+    "figure",
+    "font",
+    "footer",
+    "form",
+    "frame",
+    "frameset",
+    "h1",
+    "h2",
+    "h3",
+    "h4",
+    "h5",
+    "h6",
+    "head",
+    "header",
+    "hgroup",
+    "hr",
+    "html",
+    "i",
+    "iframe",
+    "image",
+    "img",
+    "input",
+    "ins",
+    "isindex",
+    "kbd",
+    "keygen",
+    "lebel",
+    "layer",
+    "legend",
+    "li",
+    "link",
+    "listing",
+    "main",
+    "map",
+    "mark",
+    "marquee",
+    "menu",
+    "meta",
+    "meter",
+    "nav",
+    "nobr",
+    "noembed",
+    "noframes",
+    "nolayer",
+    "noscript",
+    "object",
+    "ol",
+    "optgroup",
+    "option",
+    "p",
+    "param",
+    "plaintext",
+    "pre",
+    "progress",
+    "q",
+    "rp",
+    "rt",
+    "ruby",
+    "s",
+    "samp",
+    "script",
+    "section",
+    "select",
+    "small",
+    "source",
+    "span",
+    "strike",
+    "strong",
+    "style",
+    "sub",
+    "summary",
+    "sup",
+    "table",
+    "tbody",
+    "td",
+    "textarea",
+    "tfoot",
+    "th",
+    "thead",
+    "title",
+    "tr",
+    "track",
+    "tt",
+    "u",
+    "ul",
+    "var",
+    "video",
+    "wbr",
+    "xmp",
+    "circle",
+    "clipPath",
+    "defs",
+    "desc",
+    "ellipse",
+    "foreignObject",
+    "g",
+    "line",
+    "linearGradient",
+    "marker",
+    "mask",
+    "metadata",
+    "path",
+    "pattern",
+    "polygon",
+    "polyline",
+    "radialGradient",
+    "rect",
+    "stop",
+    "svg",
+    "switch",
+    "symbol",
+    "text",
+    "textPath",
+    "tref",
+    "tspan",
+    "use",
+    "annotation-xml",
+    "malignmark",
+    "math",
+    "mglyph",
+    "mi",
+    "mn",
+    "mo",
+    "ms",
+    "mtext",
+    "rel",
+    "cellspacing",
+    "bordercolor",
+    "background",
+    "bgcolor",
+    "valign",
+    "vspace",
+    "hspace",
+    "value",
+    "start",
+    "border",
+    "alt",
+    "checked",
+    "class",
+    "color",
+    "disabled",
+    "enabled",
+    "face",
+    "height",
+    "href",
+    "id",
+    "lang",
+    "size",
+    "src",
+    "type",
+    "width",
+    "attributeName",
+    "attributeType",
+    "baseFrequency",
+    "baseProfile",
+    "calcMode",
+    "diffuseConstant",
+    "edgeMode",
+    "filterUnits",
+    "kernelMatrix",
+    "kernelUnitLength",
+    "keyPoints",
+    "keySplines",
+    "keyTimes",
+    "limitingConeAngle",
+    "numOctaves",
+    "pathLength",
+    "pointsAtX",
+    "pointsAtY",
+    "pointsAtZ",
+    "preserveAlpha",
+    "primitiveUnits",
+    "repeatCount",
+    "repeatDur",
+    "requiredExtensions",
+    "requiredFeatures",
+    "specularConstant",
+    "specularExponent",
+    "stdDeviation",
+    "stitchTiles",
+    "surfaceScale",
+    "systemLanguage",
+    "tableValues",
+    "targetX",
+    "targetY",
+    "viewTarget",
+    "xChannelSelector",
+    "yChannelSelector",
+    "zoomAndPan",
+    "clip",
+    "clipPathUnits",
+    "clip-path",
+    "clip-rule",
+    "cx",
+    "cy",
+    "d",
+    "display",
+    "dx",
+    "dy",
+    "fill",
+    "fill-opacity",
+    "fill-rule",
+    "font-family",
+    "font-size",
+    "font-size-adjust",
+    "font-stretch",
+    "font-style",
+    "font-variant",
+    "font-weight",
+    "fx",
+    "fy",
+    "gradientTransform",
+    "gradientUnits",
+    "lengthAdjust",
+    "letter-spacing",
+    "markerHeight",
+    "markerUnits",
+    "markerWidth",
+    "marker-end",
+    "marker-mid",
+    "marker-start",
+    "maskContentUnits",
+    "maskUnits",
+    "overflow",
+    "overline-position",
+    "overline-thickness",
+    "patternContentUnits",
+    "patternTransform",
+    "patternUnits",
+    "points",
+    "preserveAspectRatio",
+    "r",
+    "refX",
+    "refY",
+    "rotate",
+    "rx",
+    "ry",
+    "spacing",
+    "spreadMethod",
+    "startOffset",
+    "stop-color",
+    "stop-opacity",
+    "strikethrough-position",
+    "strikethrough-thickness",
+    "stroke",
+    "stroke-dasharray",
+    "stroke-dashoffset",
+    "stroke-linecap",
+    "stroke-linejoin",
+    "stroke-miterlimit",
+    "stroke-opacity",
+    "stroke-width",
+    "textLength",
+    "text-anchor",
+    "text-decoration",
+    "transform",
+    "underline-position",
+    "underline-thickness",
+    "unicode",
+    "unicode-bidi",
+    "unicode-range",
+    "viewBox",
+    "visibility",
+    "word-spacing",
+    "writing-mode",
+    "x",
+    "x1",
+    "x2",
+    "y",
+    "y1",
+    "y2",
+    "encoding",
+    "list-item",
+    "colspan",
+    "rowspan",
+    "altglyph",
+    "altglyphdef",
+    "altglyphitem",
+    "animatecolor",
+    "animatemotion",
+    "animatetransform",
+    "clippath",
+    "feblend",
+    "fecolormatrix",
+    "fecomponenttransfer",
+    "fecomposite",
+    "feconvolvematrix",
+    "fediffuselighting",
+    "fedisplacementmap",
+    "fedistantlight",
+    "fedropshadow",
+    "feflood",
+    "fefunca",
+    "fefuncb",
+    "fefuncg",
+    "fefuncr",
+    "fegaussianblur",
+    "feimage",
+    "femerge",
+    "femergenode",
+    "femorphology",
+    "feoffset",
+    "fepointlight",
+    "fespecularlighting",
+    "fespotlight",
+    "glyphref",
+    "lineargradient",
+    "radialgradient",
+    "textpath",
+    "attributename",
+    "attributetype",
+    "basefrequency",
+    "baseprofile",
+    "calcmode",
+    "clippathunits",
+    "diffuseconstant",
+    "edgemode",
+    "filterunits",
+    "gradienttransform",
+    "gradientunits",
+    "kernelmatrix",
+    "kernelunitlength",
+    "keypoints",
+    "keysplines",
+    "keytimes",
+    "lengthadjust",
+    "limitingconeangle",
+    "markerheight",
+    "markerunits",
+    "markerwidth",
+    "maskcontentunits",
+    "maskunits",
+    "numoctaves",
+    "pathlength",
+    "patterncontentunits",
+    "patterntransform",
+    "patternunits",
+    "pointsatx",
+    "pointsaty",
+    "pointsatz",
+    "preservealpha",
+    "preserveaspectratio",
+    "primitiveunits",
+    "refx",
+    "refy",
+    "repeatcount",
+    "repeatdur",
+    "requiredextensions",
+    "requiredfeatures",
+    "specularconstant",
+    "specularexponent",
+    "spreadmethod",
+    "startoffset",
+    "stddeviation",
+    "stitchtiles",
+    "surfacescale",
+    "systemlanguage",
+    "tablevalues",
+    "targetx",
+    "targety",
+    "textlength",
+    "viewbox",
+    "viewtarget",
+    "xchannelselector",
+    "ychannelselector",
+    "zoomandpan",
+    "definitionurl",
+    "\"",
+};
+
+constexpr size_t kNumPredeclaredNames = std::size(predeclaredNames);
+
+constexpr uint64_t hashName(const std::string_view& name)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for(auto cc : name) {
+        hash ^= static_cast<uint8_t>(cc);
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+constexpr uint32_t mixHash(uint64_t hash, uint32_t seed)
+{
+    hash ^= (seed + 1) * 0x9e3779b97f4a7c15;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccd;
+    hash ^= hash >> 33;
+    return static_cast<uint32_t>(hash);
+}
+
+class PredeclaredNameTable {
+public:
+    constexpr PredeclaredNameTable();
+
+    constexpr int find(const std::string_view& name) const {
+        auto hash = hashName(name);
+        auto slot = mixHash(hash, m_seeds[hash % kNumBuckets]) % kNumSlots;
+        auto index = m_slots[slot];
+        if(index != -1 && predeclaredNames[index] == name)
+            return index;
+        return -1;
+    }
+
+private:
+    static constexpr uint32_t kNumBuckets = 128;
+    static constexpr uint32_t kNumSlots = 1024;
+    static constexpr uint32_t kMaxSeeds = 1 << 16;
+    std::array<uint32_t, kNumBuckets> m_seeds{};
+    std::array<int16_t, kNumSlots> m_slots{};
+};
+
+constexpr PredeclaredNameTable::PredeclaredNameTable()
+{
+    std::array<uint64_t, kNumPredeclaredNames> hashes{};
+    std::array<uint32_t, kNumBuckets> bucketSizes{};
+    for(size_t index = 0; index < kNumPredeclaredNames; ++index) {
+        hashes[index] = hashName(predeclaredNames[index]);
+        bucketSizes[hashes[index] % kNumBuckets] += 1;
+    }
+
+    std::array<uint32_t, kNumBuckets> buckets{};
+    for(uint32_t bucket = 0; bucket < kNumBuckets; ++bucket)
+        buckets[bucket] = bucket;
+    std::sort(buckets.begin(), buckets.end(), [&](auto a, auto b) { return bucketSizes[a] > bucketSizes[b]; });
+
+    m_slots.fill(-1);
+    for(auto bucket : buckets) {
+        std::array<int16_t, kNumPredeclaredNames> members{};
+        size_t count = 0;
+        for(size_t index = 0; index < kNumPredeclaredNames; ++index) {
+            if(hashes[index] % kNumBuckets == bucket) {
+                members[count++] = index;
+            }
+        }
+
+        for(uint32_t seed = 0; count > 0; ++seed) {
+            if(seed == kMaxSeeds)
+                throw std::logic_error("no perfect hash seed for the predeclared names");
+            std::array<uint32_t, kNumPredeclaredNames> slots{};
+            bool placed = true;
+            for(size_t i = 0; placed && i < count; ++i) {
+                slots[i] = mixHash(hashes[members[i]], seed) % kNumSlots;
+                placed = m_slots[slots[i]] == -1;
+                for(size_t j = 0; placed && j < i; ++j) {
+                    placed = slots[i] != slots[j];
+                }
+            }
+
+            if(placed) {
+                for(size_t i = 0; i < count; ++i)
+                    m_slots[slots[i]] = members[i];
+                m_seeds[bucket] = seed;
+                break;
+            }
+        }
+    }
+}
+
+constexpr PredeclaredNameTable predeclaredNameTable;
+
+static_assert(predeclaredNameTable.find("div") != -1);
+static_assert(predeclaredNameTable.find("not-a-predeclared-name") == -1);
+
+consteval std::string_view predeclared(const std::string_view& name)
+{
+    if(predeclaredNameTable.find(name) == -1)
+        throw std::logic_error("GlobalString definition is missing from predeclaredNames");
+    return name;
+}
+
+} // namespace
+
+class GlobalStringTable {
+public:
+    static GlobalStringTable* instance();
+
+    HeapString add(const std::string_view& value);
+    HeapString retain(const std::string_view& value);
+    void release(const std::string_view& value);
+
+private:
+    GlobalStringTable();
+
+    struct Entry {
+        std::unique_ptr<char[]> storage;
+        std::atomic<size_t> refCount{0};
+        bool permanent{false};
+    };
+
+    using EntryMap = std::unordered_map<std::string_view, Entry>;
+
+    struct Shard {
+        std::shared_mutex mutex;
+        EntryMap table;
+    };
+
+    Shard& shard(const std::string_view& value) { return m_shards[std::hash<std::string_view>()(value) % kNumShards]; }
+    static EntryMap::iterator insert(Shard& shard, const std::string_view& value);
+
+    static constexpr size_t kNumShards = 16;
+    std::array<Shard, kNumShards> m_shards;
+    std::array<HeapString, kNumPredeclaredNames> m_predeclaredNames;
+    Heap m_heap;
+};
+
+GlobalStringTable::GlobalStringTable()
+    : m_heap(1024 * 8)
+{
+    for(size_t index = 0; index < kNumPredeclaredNames; ++index) {
+        m_predeclaredNames[index] = HeapString::create(&m_heap, predeclaredNames[index]);
+    }
+}
+
+GlobalStringTable* GlobalStringTable::instance()
+{
+    static auto table = new GlobalStringTable;
+    return table;
+}
+
+GlobalStringTable::EntryMap::iterator GlobalStringTable::insert(Shard& shard, const std::string_view& value)
+{
+    auto it = shard.table.find(value);
+    if(it != shard.table.end())
+        return it;
+    auto storage = std::make_unique<char[]>(value.length());
+    std::memcpy(storage.get(), value.data(), value.length());
+    std::string_view key(storage.get(), value.length());
+    it = shard.table.try_emplace(key).first;
+    it->second.storage = std::move(storage);
+    return it;
+}
+
+HeapString GlobalStringTable::add(const std::string_view& value)
+{
+    if(auto index = predeclaredNameTable.find(value); index != -1)
+        return m_predeclaredNames[index];
+    auto& shard = this->shard(value);
+    {
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.table.find(value);
+        if(it != shard.table.end() && it->second.permanent) {
+            return it->first;
+        }
+    }
+
+    std::unique_lock lock(shard.mutex);
+    auto it = insert(shard, value);
+    it->second.permanent = true;
+    return it->first;
+}
+
+HeapString GlobalStringTable::retain(const std::string_view& value)
+{
+    if(auto index = predeclaredNameTable.find(value); index != -1)
+        return m_predeclaredNames[index];
+    auto& shard = this->shard(value);
+    {
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.table.find(value);
+        if(it != shard.table.end()) {
+            it->second.refCount.fetch_add(1, std::memory_order_relaxed);
+            return it->first;
+        }
+    }
+
+    std::unique_lock lock(shard.mutex);
+    auto it = insert(shard, value);
+    it->second.refCount.fetch_add(1, std::memory_order_relaxed);
+    return it->first;
+}
+
+void GlobalStringTable::release(const std::string_view& value)
+{
+    if(predeclaredNameTable.find(value) != -1)
+        return;
+    auto& shard = this->shard(value);
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.table.find(value);
+    assert(it != shard.table.end());
+    if(it->second.refCount.fetch_sub(1, std::memory_order_relaxed) == 1 && !it->second.permanent) {
+        shard.table.erase(it);
+    }
+}
+
 GlobalString::GlobalString(const std::string_view& value)
     : m_value(add(value))
 {
@@ -11,383 +688,410 @@ GlobalString::GlobalString(const std::string_view& value)
 
 HeapString GlobalString::add(const std::string_view& value)
 {
-    static Heap heap(1024 * 25);
-    static std::pmr::set<HeapString, std::less<>> table(&heap);
-    auto lb = table.lower_bound(value);
-    if(lb != table.end() && *lb == value)
-        return *lb;
-    return *table.emplace_hint(lb, HeapString::create(&heap, value));
+    return GlobalStringTable::instance()->add(value);
+}
+
+GlobalString GlobalString::retain(const std::string_view& value)
+{
+    GlobalString name;
+    name.m_value = GlobalStringTable::instance()->retain(value);
+    return name;
+}
+
+void GlobalString::release(const GlobalString& name)
+{
+    GlobalStringTable::instance()->release(name);
+}
+
+GlobalStringPool::GlobalStringPool(Heap* heap)
+    : m_names(heap)
+{
+}
+
+GlobalStringPool::~GlobalStringPool()
+{
+    for(auto& name : m_names) {
+        GlobalString::release(name);
+    }
+}
+
+GlobalString GlobalStringPool::add(const std::string_view& value)
+{
+    auto it = m_names.lower_bound(value);
+    if(it == m_names.end() || *it != value)
+        it = m_names.emplace_hint(it, GlobalString::retain(value));
+    return *it;
 }
 
 const GlobalString nullGlo;
-const GlobalString emptyGlo("");
-const GlobalString starGlo("*");
+const GlobalString emptyGlo(predeclared(""));
+const GlobalString starGlo(predeclared("*"));
 
 namespace namespaceuri {
 
-const GlobalString xhtml("http://www.w3.org/1999/xhtml");
-const GlobalString mathml("http://www.w3.org/1998/Math/MathML");
-const GlobalString svg("http://www.w3.org/2000/svg");
+const GlobalString xhtml(predeclared("http://www.w3.org/1999/xhtml"));
+const GlobalString mathml(predeclared("http://www.w3.org/1998/Math/MathML"));
+const GlobalString svg(predeclared("http://www.w3.org/2000/svg"));
 
 } // namespace namespaceuri
 
-const GlobalString altGlyphTag("altGlyph");
-const GlobalString altGlyphDefTag("altGlyphDef");
-const GlobalString altGlyphItemTag("altGlyphItem");
-const GlobalString animateColorTag("animateColor");
-const GlobalString animateMotionTag("animateMotion");
-const GlobalString animateTransformTag("animateTransform");
-const GlobalString feBlendTag("feBlend");
-const GlobalString feColorMatrixTag("feColorMatrix");
-const GlobalString feComponentTransferTag("feComponentTransfer");
-const GlobalString feCompositeTag("feComposite");
-const GlobalString feConvolveMatrixTag("feConvolveMatrix");
-const GlobalString feDiffuseLightingTag("feDiffuseLighting");
-const GlobalString feDisplacementMapTag("feDisplacementMap");
-const GlobalString feDistantLightTag("feDistantLight");
-const GlobalString feDropShadowTag("feDropShadow");
-const GlobalString feFloodTag("feFlood");
-const GlobalString feFuncATag("feFuncA");
-const GlobalString feFuncBTag("feFuncB");
-const GlobalString feFuncGTag("feFuncG");
-const GlobalString feFuncRTag("feFuncR");
-const GlobalString feGaussianBlurTag("feGaussianBlur");
-const GlobalString feImageTag("feImage");
-const GlobalString feMergeTag("feMergeNode");
-const GlobalString feMergeNodeTag("");
-const GlobalString feMorphologyTag("feMorphology");
-const GlobalString feOffsetTag("feOffset");
-const GlobalString fePointLightTag("fePointLight");
-const GlobalString feSpecularLightingTag("feSpecularLighting");
-const GlobalString feSpotLightTag("feSpotLight");
-const GlobalString glyphRefTag("glyphRef");
-const GlobalString definitionUrlTag("definitionUrl");
-
-const GlobalString aTag("a");
-const GlobalString abbrTag("abbr");
-const GlobalString acronymTag("acronym");
-const GlobalString addressTag("address");
-const GlobalString appletTag("applet");
-const GlobalString areaTag("area");
-const GlobalString articleTag("article");
-const GlobalString asideTag("aside");
-const GlobalString audioTag("audio");
-const GlobalString bTag("b");
-const GlobalString baseTag("base");
-const GlobalString basefontTag("basefont");
-const GlobalString bgsoundTag("bgsound");
-const GlobalString bigTag("big");
-const GlobalString blockquoteTag("blockquote");
-const GlobalString bodyTag("body");
-const GlobalString brTag("br");
-const GlobalString buttonTag("button");
-const GlobalString canvasTag("canvas");
-const GlobalString captionTag("caption");
-const GlobalString centerTag("center");
-const GlobalString citeTag("cite");
-const GlobalString codeTag("code");
-const GlobalString colTag("col");
-const GlobalString colgroupTag("colgroup");
-const GlobalString commandTag("command");
-const GlobalString datagridTag("datagrid");
-const GlobalString datalistTag("datalist");
-const GlobalString dcellTag("dcell");
-const GlobalString dcolTag("dcol");
-const GlobalString ddTag("dd");
-const GlobalString detailsTag("details");
-const GlobalString delTag("del");
-const GlobalString dfnTag("dfn");
-const GlobalString dirTag("dir");
-const GlobalString divTag("div");
-const GlobalString dlTag("dl");
-const GlobalString drowTag("drow");
-const GlobalString dtTag("dt");
-const GlobalString emTag("em");
-const GlobalString embedTag("embed");
-const GlobalString fieldsetTag("fieldset");
-const GlobalString figcaptionTag("figcaption");
-const GlobalString figureTag("figure");
-const GlobalString fontTag("font");
-const GlobalString footerTag("footer");
-const GlobalString formTag("form");
-const GlobalString frameTag("frame");
-const GlobalString framesetTag("frameset");
-const GlobalString h1Tag("h1");
-const GlobalString h2Tag("h2");
-const GlobalString h3Tag("h3");
-const GlobalString h4Tag("h4");
-const GlobalString h5Tag("h5");
-const GlobalString h6Tag("h6");
-const GlobalString headTag("head");
-const GlobalString headerTag("header");
-const GlobalString hgroupTag("hgroup");
-const GlobalString hrTag("hr");
-const GlobalString htmlTag("html");
-const GlobalString iTag("i");
-const GlobalString iframeTag("iframe");
-const GlobalString imageTag("image");
-const GlobalString imgTag("img");
-const GlobalString inputTag("input");
-const GlobalString insTag("ins");
-const GlobalString isindexTag("isindex");
-const GlobalString kbdTag("kbd");
-const GlobalString keygenTag("keygen");
-const GlobalString labelTag("lebel");
-const GlobalString layerTag("layer");
-const GlobalString legendTag("legend");
-const GlobalString liTag("li");
-const GlobalString linkTag("link");
-const GlobalString listingTag("listing");
-const GlobalString mainTag("main");
-const GlobalString mapTag("map");
-const GlobalString markTag("mark");
-const GlobalString marqueeTag("marquee");
-const GlobalString menuTag("menu");
-const GlobalString metaTag("meta");
-const GlobalString meterTag("meter");
-const GlobalString navTag("nav");
-const GlobalString nobrTag("nobr");
-const GlobalString noembedTag("noembed");
-const GlobalString noframesTag("noframes");
-const GlobalString nolayerTag("nolayer");
-const GlobalString noscriptTag("noscript");
-const GlobalString objectTag("object");
-const GlobalString olTag("ol");
-const GlobalString optgroupTag("optgroup");
-const GlobalString optionTag("option");
-const GlobalString pTag("p");
-const GlobalString paramTag("param");
-const GlobalString plaintextTag("plaintext");
-const GlobalString preTag("pre");
-const GlobalString progressTag("progress");
-const GlobalString qTag("q");
-const GlobalString rpTag("rp");
-const GlobalString rtTag("rt");
-const GlobalString rubyTag("ruby");
-const GlobalString sTag("s");
-const GlobalString sampTag("samp");
-const GlobalString scriptTag("script");
-const GlobalString sectionTag("section");
-const GlobalString selectTag("select");
-const GlobalString smallTag("small");
-const GlobalString sourceTag("source");
-const GlobalString spanTag("span");
-const GlobalString strikeTag("strike");
-const GlobalString strongTag("strong");
-const GlobalString styleTag("style");
-const GlobalString subTag("sub");
-const GlobalString summaryTag("summary");
-const GlobalString supTag("sup");
-const GlobalString tableTag("table");
-const GlobalString tbodyTag("tbody");
-const GlobalString tdTag("td");
-const GlobalString textareaTag("textarea");
-const GlobalString tfootTag("tfoot");
-const GlobalString thTag("th");
-const GlobalString theadTag("thead");
-const GlobalString titleTag("title");
-const GlobalString trTag("tr");
-const GlobalString trackTag("track");
-const GlobalString ttTag("tt");
-const GlobalString uTag("u");
-const GlobalString ulTag("ul");
-const GlobalString varTag("var");
-const GlobalString videoTag("video");
-const GlobalString wbrTag("wbr");
-const GlobalString xmpTag("xmp");
-
-const GlobalString circleTag("circle");
-const GlobalString clipPathTag("clipPath");
-const GlobalString defsTag("defs");
-const GlobalString descTag("desc");
-const GlobalString ellipseTag("ellipse");
-const GlobalString foreignObjectTag("foreignObject");
-const GlobalString gTag("g");
-const GlobalString lineTag("line");
-const GlobalString linearGradientTag("linearGradient");
-const GlobalString markerTag("marker");
-const GlobalString maskTag("mask");
-const GlobalString metadataTag("metadata");
-const GlobalString pathTag("path");
-const GlobalString patternTag("pattern");
-const GlobalString polygonTag("polygon");
-const GlobalString polylineTag("polyline");
-const GlobalString radialGradientTag("radialGradient");
-const GlobalString rectTag("rect");
-const GlobalString stopTag("stop");
-const GlobalString svgTag("svg");
-const GlobalString switchTag("switch");
-const GlobalString symbolTag("symbol");
-const GlobalString textTag("text");
-const GlobalString textPathTag("textPath");
-const GlobalString trefTag("tref");
-const GlobalString tspanTag("tspan");
-const GlobalString useTag("use");
-
-const GlobalString annotation_xmlTag("annotation-xml");
-const GlobalString malignmarkTag("malignmark");
-const GlobalString mathTag("math");
-const GlobalString mglyphTag("mglyph");
-const GlobalString miTag("mi");
-const GlobalString mnTag("mn");
-const GlobalString moTag("mo");
-const GlobalString msTag("ms");
-const GlobalString mtextTag("mtext");
-
-const GlobalString relAttr("rel");
-const GlobalString cellspacingAttr("cellspacing");
-const GlobalString bordercolorAttr("bordercolor");
-const GlobalString textAttr("text");
-const GlobalString backgroundAttr("background");
-const GlobalString bgcolorAttr("bgcolor");
-const GlobalString valignAttr("valign");
-const GlobalString vspaceAttr("vspace");
-const GlobalString hspaceAttr("hspace");
-const GlobalString valueAttr("value");
-const GlobalString startAttr("start");
-const GlobalString borderAttr("border");
-const GlobalString altAttr("alt");
-const GlobalString checkedAttr("checked");
-const GlobalString classAttr("class");
-const GlobalString colorAttr("color");
-const GlobalString disabledAttr("disabled");
-const GlobalString enabledAttr("enabled");
-const GlobalString faceAttr("face");
-const GlobalString heightAttr("height");
-const GlobalString hrefAttr("href");
-const GlobalString idAttr("id");
-const GlobalString langAttr("lang");
-const GlobalString sizeAttr("size");
-const GlobalString srcAttr("src");
-const GlobalString styleAttr("style");
-const GlobalString typeAttr("type");
-const GlobalString widthAttr("width");
-
-const GlobalString attributeNameAttr("attributeName");
-const GlobalString attributeTypeAttr("attributeType");
-const GlobalString baseFrequencyAttr("baseFrequency");
-const GlobalString baseProfileAttr("baseProfile");
-const GlobalString calcModeAttr("calcMode");
-const GlobalString diffuseConstantAttr("diffuseConstant");
-const GlobalString edgeModeAttr("edgeMode");
-const GlobalString filterUnitsAttr("filterUnits");
-const GlobalString glyphRefAttr("glyphRef");
-const GlobalString kernelMatrixAttr("kernelMatrix");
-const GlobalString kernelUnitLengthAttr("kernelUnitLength");
-const GlobalString keyPointsAttr("keyPoints");
-const GlobalString keySplinesAttr("keySplines");
-const GlobalString keyTimesAttr("keyTimes");
-const GlobalString limitingConeAngleAttr("limitingConeAngle");
-const GlobalString numOctavesAttr("numOctaves");
-const GlobalString pathLengthAttr("pathLength");
-const GlobalString pointsAtXAttr("pointsAtX");
-const GlobalString pointsAtYAttr("pointsAtY");
-const GlobalString pointsAtZAttr("pointsAtZ");
-const GlobalString preserveAlphaAttr("preserveAlpha");
-const GlobalString primitiveUnitsAttr("primitiveUnits");
-const GlobalString repeatCountAttr("repeatCount");
-const GlobalString repeatDurAttr("repeatDur");
-const GlobalString requiredExtensionsAttr("requiredExtensions");
-const GlobalString requiredFeaturesAttr("requiredFeatures");
-const GlobalString specularConstantAttr("specularConstant");
-const GlobalString specularExponentAttr("specularExponent");
-const GlobalString stdDeviationAttr("stdDeviation");
-const GlobalString stitchTilesAttr("stitchTiles");
-const GlobalString surfaceScaleAttr("surfaceScale");
-const GlobalString systemLanguageAttr("systemLanguage");
-const GlobalString tableValuesAttr("tableValues");
-const GlobalString targetXAttr("targetX");
-const GlobalString targetYAttr("targetY");
-const GlobalString viewTargetAttr("viewTarget");
-const GlobalString xChannelSelectorAttr("xChannelSelector");
-const GlobalString yChannelSelectorAttr("yChannelSelector");
-const GlobalString zoomAndPanAttr("zoomAndPan");
-
-const GlobalString clipAttr("clip");
-const GlobalString clipPathUnitsAttr("clipPathUnits");
-const GlobalString clip_pathAttr("clip-path");
-const GlobalString clip_ruleAttr("clip-rule");
-const GlobalString cxAttr("cx");
-const GlobalString cyAttr("cy");
-const GlobalString dAttr("d");
-const GlobalString displayAttr("display");
-const GlobalString dxAttr("dx");
-const GlobalString dyAttr("dy");
-const GlobalString fillAttr("fill");
-const GlobalString fill_opacityAttr("fill-opacity");
-const GlobalString fill_ruleAttr("fill-rule");
-const GlobalString font_familyAttr("font-family");
-const GlobalString font_sizeAttr("font-size");
-const GlobalString font_size_adjustAttr("font-size-adjust");
-const GlobalString font_stretchAttr("font-stretch");
-const GlobalString font_styleAttr("font-style");
-const GlobalString font_variantAttr("font-variant");
-const GlobalString font_weightAttr("font-weight");
-const GlobalString fxAttr("fx");
-const GlobalString fyAttr("fy");
-const GlobalString gradientTransformAttr("gradientTransform");
-const GlobalString gradientUnitsAttr("gradientUnits");
-const GlobalString lengthAdjustAttr("lengthAdjust");
-const GlobalString letter_spacingAttr("letter-spacing");
-const GlobalString markerHeightAttr("markerHeight");
-const GlobalString markerUnitsAttr("markerUnits");
-const GlobalString markerWidthAttr("markerWidth");
-const GlobalString marker_endAttr("marker-end");
-const GlobalString marker_midAttr("marker-mid");
-const GlobalString marker_startAttr("marker-start");
-const GlobalString maskAttr("mask");
-const GlobalString maskContentUnitsAttr("maskContentUnits");
-const GlobalString maskUnitsAttr("maskUnits");
-const GlobalString overflowAttr("overflow");
-const GlobalString overline_positionAttr("overline-position");
-const GlobalString overline_thicknessAttr("overline-thickness");
-const GlobalString pathAttr("path");
-const GlobalString patternContentUnitsAttr("patternContentUnits");
-const GlobalString patternTransformAttr("patternTransform");
-const GlobalString patternUnitsAttr("patternUnits");
-const GlobalString pointsAttr("points");
-const GlobalString preserveAspectRatioAttr("preserveAspectRatio");
-const GlobalString rAttr("r");
-const GlobalString refXAttr("refX");
-const GlobalString refYAttr("refY");
-const GlobalString rotateAttr("rotate");
-const GlobalString rxAttr("rx");
-const GlobalString ryAttr("ry");
-const GlobalString spacingAttr("spacing");
-const GlobalString spreadMethodAttr("spreadMethod");
-const GlobalString startOffsetAttr("startOffset");
-const GlobalString stop_colorAttr("stop-color");
-const GlobalString stop_opacityAttr("stop-opacity");
-const GlobalString strikethrough_positionAttr("strikethrough-position");
-const GlobalString strikethrough_thicknessAttr("strikethrough-thickness");
-const GlobalString strokeAttr("stroke");
-const GlobalString stroke_dasharrayAttr("stroke-dasharray");
-const GlobalString stroke_dashoffsetAttr("stroke-dashoffset");
-const GlobalString stroke_linecapAttr("stroke-linecap");
-const GlobalString stroke_linejoinAttr("stroke-linejoin");
-const GlobalString stroke_miterlimitAttr("stroke-miterlimit");
-const GlobalString stroke_opacityAttr("stroke-opacity");
-const GlobalString stroke_widthAttr("stroke-width");
-const GlobalString textLengthAttr("textLength");
-const GlobalString text_anchorAttr("text-anchor");
-const GlobalString text_decorationAttr("text-decoration");
-const GlobalString titleAttr("title");
-const GlobalString transformAttr("transform");
-const GlobalString underline_positionAttr("underline-position");
-const GlobalString underline_thicknessAttr("underline-thickness");
-const GlobalString unicodeAttr("unicode");
-const GlobalString unicode_bidiAttr("unicode-bidi");
-const GlobalString unicode_rangeAttr("unicode-range");
-const GlobalString viewBoxAttr("viewBox");
-const GlobalString visibilityAttr("visibility");
-const GlobalString word_spacingAttr("word-spacing");
-const GlobalString writing_modeAttr("writing-mode");
-const GlobalString xAttr("x");
-const GlobalString x1Attr("x1");
-const GlobalString x2Attr("x2");
-const GlobalString yAttr("y");
-const GlobalString y1Attr("y1");
-const GlobalString y2Attr("y2");
-const GlobalString encodingAttr("encoding");
+const GlobalString altGlyphTag(predeclared("altGlyph"));
+const GlobalString altGlyphDefTag(predeclared("altGlyphDef"));
+const GlobalString altGlyphItemTag(predeclared("altGlyphItem"));
+const GlobalString animateColorTag(predeclared("animateColor"));
+const GlobalString animateMotionTag(predeclared("animateMotion"));
+const GlobalString animateTransformTag(predeclared("animateTransform"));
+const GlobalString feBlendTag(predeclared("feBlend"));
+const GlobalString feColorMatrixTag(predeclared("feColorMatrix"));
+const GlobalString feComponentTransferTag(predeclared("feComponentTransfer"));
+const GlobalString feCompositeTag(predeclared("feComposite"));
+const GlobalString feConvolveMatrixTag(predeclared("feConvolveMatrix"));
+const GlobalString feDiffuseLightingTag(predeclared("feDiffuseLighting"));
+const GlobalString feDisplacementMapTag(predeclared("feDisplacementMap"));
+const GlobalString feDistantLightTag(predeclared("feDistantLight"));
+const GlobalString feDropShadowTag(predeclared("feDropShadow"));
+const GlobalString feFloodTag(predeclared("feFlood"));
+const GlobalString feFuncATag(predeclared("feFuncA"));
+const GlobalString feFuncBTag(predeclared("feFuncB"));
+const GlobalString feFuncGTag(predeclared("feFuncG"));
+const GlobalString feFuncRTag(predeclared("feFuncR"));
+const GlobalString feGaussianBlurTag(predeclared("feGaussianBlur"));
+const GlobalString feImageTag(predeclared("feImage"));
+const GlobalString feMergeTag(predeclared("feMerge"));
+const GlobalString feMergeNodeTag(predeclared("feMergeNode"));
+const GlobalString feMorphologyTag(predeclared("feMorphology"));
+const GlobalString feOffsetTag(predeclared("feOffset"));
+const GlobalString fePointLightTag(predeclared("fePointLight"));
+const GlobalString feSpecularLightingTag(predeclared("feSpecularLighting"));
+const GlobalString feSpotLightTag(predeclared("feSpotLight"));
+const GlobalString glyphRefTag(predeclared("glyphRef"));
+const GlobalString definitionUrlTag(predeclared("definitionUrl"));
+
+const GlobalString aTag(predeclared("a"));
+const GlobalString abbrTag(predeclared("abbr"));
+const GlobalString acronymTag(predeclared("acronym"));
+const GlobalString addressTag(predeclared("address"));
+const GlobalString appletTag(predeclared("applet"));
+const GlobalString areaTag(predeclared("area"));
+const GlobalString articleTag(predeclared("article"));
+const GlobalString asideTag(predeclared("aside"));
+const GlobalString audioTag(predeclared("audio"));
+const GlobalString bTag(predeclared("b"));
+const GlobalString baseTag(predeclared("base"));
+const GlobalString basefontTag(predeclared("basefont"));
+const GlobalString bgsoundTag(predeclared("bgsound"));
+const GlobalString bigTag(predeclared("big"));
+const GlobalString blockquoteTag(predeclared("blockquote"));
+const GlobalString bodyTag(predeclared("body"));
+const GlobalString brTag(predeclared("br"));
+const GlobalString buttonTag(predeclared("button"));
+const GlobalString canvasTag(predeclared("canvas"));
+const GlobalString captionTag(predeclared("caption"));
+const GlobalString centerTag(predeclared("center"));
+const GlobalString citeTag(predeclared("cite"));
+const GlobalString codeTag(predeclared("code"));
+const GlobalString colTag(predeclared("col"));
+const GlobalString colgroupTag(predeclared("colgroup"));
+const GlobalString commandTag(predeclared("command"));
+const GlobalString datagridTag(predeclared("datagrid"));
+const GlobalString datalistTag(predeclared("datalist"));
+const GlobalString dcellTag(predeclared("dcell"));
+const GlobalString dcolTag(predeclared("dcol"));
+const GlobalString ddTag(predeclared("dd"));
+const GlobalString detailsTag(predeclared("details"));
+const GlobalString delTag(predeclared("del"));
+const GlobalString dfnTag(predeclared("dfn"));
+const GlobalString dirTag(predeclared("dir"));
+const GlobalString divTag(predeclared("div"));
+const GlobalString dlTag(predeclared("dl"));
+const GlobalString drowTag(predeclared("drow"));
+const GlobalString dtTag(predeclared("dt"));
+const GlobalString emTag(predeclared("em"));
+const GlobalString embedTag(predeclared("embed"));
+const GlobalString fieldsetTag(predeclared("fieldset"));
+const GlobalString figcaptionTag(predeclared("figcaption"));
+const GlobalString figureTag(predeclared("figure"));
+const GlobalString fontTag(predeclared("font"));
+const GlobalString footerTag(predeclared("footer"));
+const GlobalString formTag(predeclared("form"));
+const GlobalString frameTag(predeclared("frame"));
+const GlobalString framesetTag(predeclared("frameset"));
+const GlobalString h1Tag(predeclared("h1"));
+const GlobalString h2Tag(predeclared("h2"));
+const GlobalString h3Tag(predeclared("h3"));
+const GlobalString h4Tag(predeclared("h4"));
+const GlobalString h5Tag(predeclared("h5"));
+const GlobalString h6Tag(predeclared("h6"));
+const GlobalString headTag(predeclared("head"));
+const GlobalString headerTag(predeclared("header"));
+const GlobalString hgroupTag(predeclared("hgroup"));
+const GlobalString hrTag(predeclared("hr"));
+const GlobalString htmlTag(predeclared("html"));
+const GlobalString iTag(predeclared("i"));
+const GlobalString iframeTag(predeclared("iframe"));
+const GlobalString imageTag(predeclared("image"));
+const GlobalString imgTag(predeclared("img"));
+const GlobalString inputTag(predeclared("input"));
+const GlobalString insTag(predeclared("ins"));
+const GlobalString isindexTag(predeclared("isindex"));
+const GlobalString kbdTag(predeclared("kbd"));
+const GlobalString keygenTag(predeclared("keygen"));
+const GlobalString labelTag(predeclared("lebel"));
+const GlobalString layerTag(predeclared("layer"));
+const GlobalString legendTag(predeclared("legend"));
+const GlobalString liTag(predeclared("li"));
+const GlobalString linkTag(predeclared("link"));
+const GlobalString listingTag(predeclared("listing"));
+const GlobalString mainTag(predeclared("main"));
+const GlobalString mapTag(predeclared("map"));
+const GlobalString markTag(predeclared("mark"));
+const GlobalString marqueeTag(predeclared("marquee"));
+const GlobalString menuTag(predeclared("menu"));
+const GlobalString metaTag(predeclared("meta"));
+const GlobalString meterTag(predeclared("meter"));
+const GlobalString navTag(predeclared("nav"));
+const GlobalString nobrTag(predeclared("nobr"));
+const GlobalString noembedTag(predeclared("noembed"));
+const GlobalString noframesTag(predeclared("noframes"));
+const GlobalString nolayerTag(predeclared("nolayer"));
+const GlobalString noscriptTag(predeclared("noscript"));
+const GlobalString objectTag(predeclared("object"));
+const GlobalString olTag(predeclared("ol"));
+const GlobalString optgroupTag(predeclared("optgroup"));
+const GlobalString optionTag(predeclared("option"));
+const GlobalString pTag(predeclared("p"));
+const GlobalString paramTag(predeclared("param"));
+const GlobalString plaintextTag(predeclared("plaintext"));
+const GlobalString preTag(predeclared("pre"));
+const GlobalString progressTag(predeclared("progress"));
+const GlobalString qTag(predeclared("q"));
+const GlobalString rpTag(predeclared("rp"));
+const GlobalString rtTag(predeclared("rt"));
+const GlobalString rubyTag(predeclared("ruby"));
+const GlobalString sTag(predeclared("s"));
+const GlobalString sampTag(predeclared("samp"));
+const GlobalString scriptTag(predeclared("script"));
+const GlobalString sectionTag(predeclared("section"));
+const GlobalString selectTag(predeclared("select"));
+const GlobalString smallTag(predeclared("small"));
+const GlobalString sourceTag(predeclared("source"));
+const GlobalString spanTag(predeclared("span"));
+const GlobalString strikeTag(predeclared("strike"));
+const GlobalString strongTag(predeclared("strong"));
+const GlobalString styleTag(predeclared("style"));
+const GlobalString subTag(predeclared("sub"));
+const GlobalString summaryTag(predeclared("summary"));
+const GlobalString supTag(predeclared("sup"));
+const GlobalString tableTag(predeclared("table"));
+const GlobalString tbodyTag(predeclared("tbody"));
+const GlobalString tdTag(predeclared("td"));
+const GlobalString textareaTag(predeclared("textarea"));
+const GlobalString tfootTag(predeclared("tfoot"));
+const GlobalString thTag(predeclared("th"));
+const GlobalString theadTag(predeclared("thead"));
+const GlobalString titleTag(predeclared("title"));
+const GlobalString trTag(predeclared("tr"));
+const GlobalString trackTag(predeclared("track"));
+const GlobalString ttTag(predeclared("tt"));
+const GlobalString uTag(predeclared("u"));
+const GlobalString ulTag(predeclared("ul"));
+const GlobalString varTag(predeclared("var"));
+const GlobalString videoTag(predeclared("video"));
+const GlobalString wbrTag(predeclared("wbr"));
+const GlobalString xmpTag(predeclared("xmp"));
+
+const GlobalString circleTag(predeclared("circle"));
+const GlobalString clipPathTag(predeclared("clipPath"));
+const GlobalString defsTag(predeclared("defs"));
+const GlobalString descTag(predeclared("desc"));
+const GlobalString ellipseTag(predeclared("ellipse"));
+const GlobalString foreignObjectTag(predeclared("foreignObject"));
+const GlobalString gTag(predeclared("g"));
+const GlobalString lineTag(predeclared("line"));
+const GlobalString linearGradientTag(predeclared("linearGradient"));
+const GlobalString markerTag(predeclared("marker"));
+const GlobalString maskTag(predeclared("mask"));
+const GlobalString metadataTag(predeclared("metadata"));
+const GlobalString pathTag(predeclared("path"));
+const GlobalString patternTag(predeclared("pattern"));
+const GlobalString polygonTag(predeclared("polygon"));
+const GlobalString polylineTag(predeclared("polyline"));
+const GlobalString radialGradientTag(predeclared("radialGradient"));
+const GlobalString rectTag(predeclared("rect"));
+const GlobalString stopTag(predeclared("stop"));
+const GlobalString svgTag(predeclared("svg"));
+const GlobalString switchTag(predeclared("switch"));
+const GlobalString symbolTag(predeclared("symbol"));
+const GlobalString textTag(predeclared("text"));
+const GlobalString textPathTag(predeclared("textPath"));
+const GlobalString trefTag(predeclared("tref"));
+const GlobalString tspanTag(predeclared("tspan"));
+const GlobalString useTag(predeclared("use"));
+
+const GlobalString annotation_xmlTag(predeclared("annotation-xml"));
+const GlobalString malignmarkTag(predeclared("malignmark"));
+const GlobalString mathTag(predeclared("math"));
+const GlobalString mglyphTag(predeclared("mglyph"));
+const GlobalString miTag(predeclared("mi"));
+const GlobalString mnTag(predeclared("mn"));
+const GlobalString moTag(predeclared("mo"));
+const GlobalString msTag(predeclared("ms"));
+const GlobalString mtextTag(predeclared("mtext"));
+
+const GlobalString relAttr(predeclared("rel"));
+const GlobalString cellspacingAttr(predeclared("cellspacing"));
+const GlobalString bordercolorAttr(predeclared("bordercolor"));
+const GlobalString textAttr(predeclared("text"));
+const GlobalString backgroundAttr(predeclared("background"));
+const GlobalString bgcolorAttr(predeclared("bgcolor"));
+const GlobalString valignAttr(predeclared("valign"));
+const GlobalString vspaceAttr(predeclared("vspace"));
+const GlobalString hspaceAttr(predeclared("hspace"));
+const GlobalString valueAttr(predeclared("value"));
+const GlobalString startAttr(predeclared("start"));
+const GlobalString borderAttr(predeclared("border"));
+const GlobalString altAttr(predeclared("alt"));
+const GlobalString checkedAttr(predeclared("checked"));
+const GlobalString classAttr(predeclared("class"));
+const GlobalString colorAttr(predeclared("color"));
+const GlobalString disabledAttr(predeclared("disabled"));
+const GlobalString enabledAttr(predeclared("enabled"));
+const GlobalString faceAttr(predeclared("face"));
+const GlobalString heightAttr(predeclared("height"));
+const GlobalString hrefAttr(predeclared("href"));
+const GlobalString idAttr(predeclared("id"));
+const GlobalString langAttr(predeclared("lang"));
+const GlobalString sizeAttr(predeclared("size"));
+const GlobalString srcAttr(predeclared("src"));
+const GlobalString styleAttr(predeclared("style"));
+const GlobalString typeAttr(predeclared("type"));
+const GlobalString widthAttr(predeclared("width"));
+
+const GlobalString attributeNameAttr(predeclared("attributeName"));
+const GlobalString attributeTypeAttr(predeclared("attributeType"));
+const GlobalString baseFrequencyAttr(predeclared("baseFrequency"));
+const GlobalString baseProfileAttr(predeclared("baseProfile"));
+const GlobalString calcModeAttr(predeclared("calcMode"));
+const GlobalString diffuseConstantAttr(predeclared("diffuseConstant"));
+const GlobalString edgeModeAttr(predeclared("edgeMode"));
+const GlobalString filterUnitsAttr(predeclared("filterUnits"));
+const GlobalString glyphRefAttr(predeclared("glyphRef"));
+const GlobalString kernelMatrixAttr(predeclared("kernelMatrix"));
+const GlobalString kernelUnitLengthAttr(predeclared("kernelUnitLength"));
+const GlobalString keyPointsAttr(predeclared("keyPoints"));
+const GlobalString keySplinesAttr(predeclared("keySplines"));
+const GlobalString keyTimesAttr(predeclared("keyTimes"));
+const GlobalString limitingConeAngleAttr(predeclared("limitingConeAngle"));
+const GlobalString numOctavesAttr(predeclared("numOctaves"));
+const GlobalString pathLengthAttr(predeclared("pathLength"));
+const GlobalString pointsAtXAttr(predeclared("pointsAtX"));
+const GlobalString pointsAtYAttr(predeclared("pointsAtY"));
+const GlobalString pointsAtZAttr(predeclared("pointsAtZ"));
+const GlobalString preserveAlphaAttr(predeclared("preserveAlpha"));
+const GlobalString primitiveUnitsAttr(predeclared("primitiveUnits"));
+const GlobalString repeatCountAttr(predeclared("repeatCount"));
+const GlobalString repeatDurAttr(predeclared("repeatDur"));
+const GlobalString requiredExtensionsAttr(predeclared("requiredExtensions"));
+const GlobalString requiredFeaturesAttr(predeclared("requiredFeatures"));
+const GlobalString specularConstantAttr(predeclared("specularConstant"));
+const GlobalString specularExponentAttr(predeclared("specularExponent"));
+const GlobalString stdDeviationAttr(predeclared("stdDeviation"));
+const GlobalString stitchTilesAttr(predeclared("stitchTiles"));
+const GlobalString surfaceScaleAttr(predeclared("surfaceScale"));
+const GlobalString systemLanguageAttr(predeclared("systemLanguage"));
+const GlobalString tableValuesAttr(predeclared("tableValues"));
+const GlobalString targetXAttr(predeclared("targetX"));
+const GlobalString targetYAttr(predeclared("targetY"));
+const GlobalString viewTargetAttr(predeclared("viewTarget"));
+const GlobalString xChannelSelectorAttr(predeclared("xChannelSelector"));
+const GlobalString yChannelSelectorAttr(predeclared("yChannelSelector"));
+const GlobalString zoomAndPanAttr(predeclared("zoomAndPan"));
+
+const GlobalString clipAttr(predeclared("clip"));
+const GlobalString clipPathUnitsAttr(predeclared("clipPathUnits"));
+const GlobalString clip_pathAttr(predeclared("clip-path"));
+const GlobalString clip_ruleAttr(predeclared("clip-rule"));
+const GlobalString cxAttr(predeclared("cx"));
+const GlobalString cyAttr(predeclared("cy"));
+const GlobalString dAttr(predeclared("d"));
+const GlobalString displayAttr(predeclared("display"));
+const GlobalString dxAttr(predeclared("dx"));
+const GlobalString dyAttr(predeclared("dy"));
+const GlobalString fillAttr(predeclared("fill"));
+const GlobalString fill_opacityAttr(predeclared("fill-opacity"));
+const GlobalString fill_ruleAttr(predeclared("fill-rule"));
+const GlobalString font_familyAttr(predeclared("font-family"));
+const GlobalString font_sizeAttr(predeclared("font-size"));
+const GlobalString font_size_adjustAttr(predeclared("font-size-adjust"));
+const GlobalString font_stretchAttr(predeclared("font-stretch"));
+const GlobalString font_styleAttr(predeclared("font-style"));
+const GlobalString font_variantAttr(predeclared("font-variant"));
+const GlobalString font_weightAttr(predeclared("font-weight"));
+const GlobalString fxAttr(predeclared("fx"));
+const GlobalString fyAttr(predeclared("fy"));
+const GlobalString gradientTransformAttr(predeclared("gradientTransform"));
+const GlobalString gradientUnitsAttr(predeclared("gradientUnits"));
+const GlobalString lengthAdjustAttr(predeclared("lengthAdjust"));
+const GlobalString letter_spacingAttr(predeclared("letter-spacing"));
+const GlobalString markerHeightAttr(predeclared("markerHeight"));
+const GlobalString markerUnitsAttr(predeclared("markerUnits"));
+const GlobalString markerWidthAttr(predeclared("markerWidth"));
+const GlobalString marker_endAttr(predeclared("marker-end"));
+const GlobalString marker_midAttr(predeclared("marker-mid"));
+const GlobalString marker_startAttr(predeclared("marker-start"));
+const GlobalString maskAttr(predeclared("mask"));
+const GlobalString maskContentUnitsAttr(predeclared("maskContentUnits"));
+const GlobalString maskUnitsAttr(predeclared("maskUnits"));
+const GlobalString overflowAttr(predeclared("overflow"));
+const GlobalString overline_positionAttr(predeclared("overline-position"));
+const GlobalString overline_thicknessAttr(predeclared("overline-thickness"));
+const GlobalString pathAttr(predeclared("path"));
+const GlobalString patternContentUnitsAttr(predeclared("patternContentUnits"));
+const GlobalString patternTransformAttr(predeclared("patternTransform"));
+const GlobalString patternUnitsAttr(predeclared("patternUnits"));
+const GlobalString pointsAttr(predeclared("points"));
+const GlobalString preserveAspectRatioAttr(predeclared("preserveAspectRatio"));
+const GlobalString rAttr(predeclared("r"));
+const GlobalString refXAttr(predeclared("refX"));
+const GlobalString refYAttr(predeclared("refY"));
+const GlobalString rotateAttr(predeclared("rotate"));
+const GlobalString rxAttr(predeclared("rx"));
+const GlobalString ryAttr(predeclared("ry"));
+const GlobalString spacingAttr(predeclared("spacing"));
+const GlobalString spreadMethodAttr(predeclared("spreadMethod"));
+const GlobalString startOffsetAttr(predeclared("startOffset"));
+const GlobalString stop_colorAttr(predeclared("stop-color"));
+const GlobalString stop_opacityAttr(predeclared("stop-opacity"));
+const GlobalString strikethrough_positionAttr(predeclared("strikethrough-position"));
+const GlobalString strikethrough_thicknessAttr(predeclared("strikethrough-thickness"));
+const GlobalString strokeAttr(predeclared("stroke"));
+const GlobalString stroke_dasharrayAttr(predeclared("stroke-dasharray"));
+const GlobalString stroke_dashoffsetAttr(predeclared("stroke-dashoffset"));
+const GlobalString stroke_linecapAttr(predeclared("stroke-linecap"));
+const GlobalString stroke_linejoinAttr(predeclared("stroke-linejoin"));
+const GlobalString stroke_miterlimitAttr(predeclared("stroke-miterlimit"));
+const GlobalString stroke_opacityAttr(predeclared("stroke-opacity"));
+const GlobalString stroke_widthAttr(predeclared("stroke-width"));
+const GlobalString textLengthAttr(predeclared("textLength"));
+const GlobalString text_anchorAttr(predeclared("text-anchor"));
+const GlobalString text_decorationAttr(predeclared("text-decoration"));
+const GlobalString titleAttr(predeclared("title"));
+const GlobalString transformAttr(predeclared("transform"));
+const GlobalString underline_positionAttr(predeclared("underline-position"));
+const GlobalString underline_thicknessAttr(predeclared("underline-thickness"));
+const GlobalString unicodeAttr(predeclared("unicode"));
+const GlobalString unicode_bidiAttr(predeclared("unicode-bidi"));
+const GlobalString unicode_rangeAttr(predeclared("unicode-range"));
+const GlobalString viewBoxAttr(predeclared("viewBox"));
+const GlobalString visibilityAttr(predeclared("visibility"));
+const GlobalString word_spacingAttr(predeclared("word-spacing"));
+const GlobalString writing_modeAttr(predeclared("writing-mode"));
+const GlobalString xAttr(predeclared("x"));
+const GlobalString x1Attr(predeclared("x1"));
+const GlobalString x2Attr(predeclared("x2"));
+const GlobalString yAttr(predeclared("y"));
+const GlobalString y1Attr(predeclared("y1"));
+const GlobalString y2Attr(predeclared("y2"));
+const GlobalString encodingAttr(predeclared("encoding"));
 
 } // namespace htmlbook
@@ -3,6 +3,8 @@
 
 #include "heapstring.h"
 
+#include <set>
+
 namespace htmlbook {
 
 class GlobalString {
@@ -19,7 +21,10 @@ public:
     operator const HeapString&() const { return m_value; }
 
 private:
+    friend class GlobalStringPool;
     static HeapString add(const std::string_view& value);
+    static GlobalString retain(const std::string_view& value);
+    static void release(const GlobalString& name);
     HeapString m_value;
 };
 
@@ -55,6 +60,17 @@ inline bool operator>(const GlobalString& a, const HeapString& b) { return a.val
 inline bool operator<(const HeapString& a, const GlobalString& b) { return a < b.value(); }
 inline bool operator>(const HeapString& a, const GlobalString& b) { return a > b.value(); }
 
+class GlobalStringPool {
+public:
+    explicit GlobalStringPool(Heap* heap);
+    ~GlobalStringPool();
+
+    GlobalString add(const std::string_view& value);
+
+private:
+    std::pmr::set<GlobalString, std::less<>> m_names;
+};
+
 extern const GlobalString nullGlo;
 extern const GlobalString emptyGlo;
 extern const GlobalString starGlo;
@@ -0,0 +1,74 @@
+#include "heapresource.h"
+
+#include <algorithm>
+#include <new>
+
+namespace htmlbook {
+
+constexpr size_t kMinHeapSize = 1024 * 25;
+constexpr size_t kHeapPageSize = 1024 * 4;
+constexpr size_t kDefaultHeapBytesPerInputByte = 4;
+constexpr size_t kMaxHeapBytesPerInputByte = 16;
+
+HeapResource::HeapResource(std::pmr::memory_resource* upstream)
+    : m_upstream(upstream)
+    , m_bytesPerInputByte(kDefaultHeapBytesPerInputByte)
+{
+}
+
+HeapResource::~HeapResource()
+{
+    release();
+}
+
+std::unique_ptr<Heap> HeapResource::createHeap(size_t inputBytes, size_t sizeHint)
+{
+    if(m_inputBytes > 0 && m_allocatedBytes > 0) {
+        auto highWaterMark = m_bufferSize + m_allocatedBytes;
+        auto bytesPerInputByte = (highWaterMark + m_inputBytes - 1) / m_inputBytes;
+        m_bytesPerInputByte = std::clamp(bytesPerInputByte, kDefaultHeapBytesPerInputByte, kMaxHeapBytesPerInputByte);
+    }
+
+    auto requiredSize = std::max({kMinHeapSize, sizeHint, inputBytes * m_bytesPerInputByte});
+    requiredSize = (requiredSize + kHeapPageSize - 1) & ~(kHeapPageSize - 1);
+    if(m_limit > 0)
+        requiredSize = std::min(requiredSize, m_limit);
+    if(requiredSize > m_bufferSize || m_bufferSize > 2 * requiredSize) {
+        if(m_buffer)
+            m_upstream->deallocate(m_buffer, m_bufferSize, alignof(std::max_align_t));
+        m_buffer = nullptr;
+        m_bufferSize = 0;
+        m_buffer = static_cast<char*>(m_upstream->allocate(requiredSize, alignof(std::max_align_t)));
+        m_bufferSize = requiredSize;
+    }
+
+    m_inputBytes = inputBytes;
+    m_allocatedBytes = 0;
+    return std::make_unique<Heap>(m_buffer, m_bufferSize, this);
+}
+
+void HeapResource::release()
+{
+    if(m_buffer) {
+        m_upstream->deallocate(m_buffer, m_bufferSize, alignof(std::max_align_t));
+        m_buffer = nullptr;
+        m_bufferSize = 0;
+    }
+
+    m_allocatedBytes = 0;
+}
+
+void* HeapResource::do_allocate(size_t bytes, size_t alignment)
+{
+    if(m_limit > 0 && m_bufferSize + m_allocatedBytes + bytes > m_limit)
+        throw std::bad_alloc();
+    m_allocatedBytes += bytes;
+    return m_upstream->allocate(bytes, alignment);
+}
+
+void HeapResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    m_upstream->deallocate(p, bytes, alignment);
+}
+
+} // namespace htmlbook
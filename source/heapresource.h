@@ -0,0 +1,41 @@
+#ifndef HEAPRESOURCE_H
+#define HEAPRESOURCE_H
+
+#include <memory_resource>
+#include <memory>
+
+namespace htmlbook {
+
+using Heap = std::pmr::monotonic_buffer_resource;
+
+class HeapResource final : public std::pmr::memory_resource {
+public:
+    explicit HeapResource(std::pmr::memory_resource* upstream);
+    ~HeapResource() final;
+
+    std::unique_ptr<Heap> createHeap(size_t inputBytes, size_t sizeHint);
+    void release();
+
+    std::pmr::memory_resource* upstream() const { return m_upstream; }
+    void setLimit(size_t limit) { m_limit = limit; }
+    size_t limit() const { return m_limit; }
+    size_t capacity() const { return m_bufferSize; }
+    size_t allocatedBytes() const { return m_allocatedBytes; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) final;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) final;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final { return this == &other; }
+
+    std::pmr::memory_resource* m_upstream;
+    char* m_buffer{nullptr};
+    size_t m_bufferSize{0};
+    size_t m_allocatedBytes{0};
+    size_t m_inputBytes{0};
+    size_t m_bytesPerInputByte;
+    size_t m_limit{0};
+};
+
+} // namespace htmlbook
+
+#endif // HEAPRESOURCE_H
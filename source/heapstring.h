@@ -39,6 +39,7 @@ public:
     static HeapString create(Heap* heap, const char* data, size_t length);
 
 private:
+    friend class GlobalStringTable;
     HeapString(const std::string_view& value) : m_value(value) {}
     std::string_view m_value;
 };
@@ -1,6 +1,11 @@
 #include "htmlbook.h"
 #include "htmldocument.h"
 #include "resource.h"
+#include "pdfwriter.h"
+#include "boxview.h"
+#include "heapresource.h"
+
+#include <fstream>
 
 namespace htmlbook {
 
@@ -14,24 +19,129 @@ const PageSize PageSize::Legal(612, 1008);
 const PageSize PageSize::Ledger(1224, 792);
 
 Book::Book(const PageSize& size, PageOrientation orientation, const PageMargins& margins)
-    : m_pageSize(size)
+    : m_heapResource(std::make_unique<HeapResource>(std::pmr::get_default_resource()))
+    , m_pageSize(size)
     , m_pageOrientation(orientation)
     , m_pageMargins(margins)
 {
 }
 
+Book::~Book() = default;
+
+void Book::setPageSize(const PageSize& pageSize)
+{
+    m_pageSize = pageSize;
+}
+
+const PageSize& Book::pageSize() const
+{
+    return m_pageSize;
+}
+
+void Book::setPageOrientation(PageOrientation orientation)
+{
+    m_pageOrientation = orientation;
+}
+
+PageOrientation Book::pageOrientation() const
+{
+    return m_pageOrientation;
+}
+
+void Book::setPageMargins(const PageMargins& margins)
+{
+    m_pageMargins = margins;
+}
+
+const PageMargins& Book::pageMargins() const
+{
+    return m_pageMargins;
+}
+
+float Book::pageWidth() const
+{
+    if(m_pageOrientation == PageOrientation::Landscape)
+        return std::max(m_pageSize.width(), m_pageSize.height());
+    return std::min(m_pageSize.width(), m_pageSize.height());
+}
+
+float Book::pageHeight() const
+{
+    if(m_pageOrientation == PageOrientation::Landscape)
+        return std::min(m_pageSize.width(), m_pageSize.height());
+    return std::max(m_pageSize.width(), m_pageSize.height());
+}
+
+void Book::setTitle(const std::string_view& title)
+{
+    m_title = title;
+}
+
+const std::string& Book::title() const
+{
+    return m_title;
+}
+
+void Book::setSubject(const std::string_view& subject)
+{
+    m_subject = subject;
+}
+
+const std::string& Book::subject() const
+{
+    return m_subject;
+}
+
+void Book::setAuthor(const std::string_view& author)
+{
+    m_author = author;
+}
+
+const std::string& Book::author() const
+{
+    return m_author;
+}
+
+void Book::setCreator(const std::string_view& creator)
+{
+    m_creator = creator;
+}
+
+const std::string& Book::creator() const
+{
+    return m_creator;
+}
+
+void Book::setCreationDate(const std::string_view& creationDate)
+{
+    m_creationDate = creationDate;
+}
+
+const std::string& Book::creationDate() const
+{
+    return m_creationDate;
+}
+
+void Book::setModificationDate(const std::string_view& modificationDate)
+{
+    m_modificationDate = modificationDate;
+}
+
+const std::string& Book::modificationDate() const
+{
+    return m_modificationDate;
+}
+
 float Book::viewportWidth() const
 {
-    return m_pageSize.width();
+    return std::max(0.f, pageWidth() - m_pageMargins.left() - m_pageMargins.right());
 }
 
 float Book::viewportHeight() const
 {
-    return m_pageSize.height();
+    return std::max(0.f, pageHeight() - m_pageMargins.top() - m_pageMargins.bottom());
 }
 
-Book::~Book() = default;
-
 void Book::loadUrl(const std::string_view& url, const std::string_view& userStyle)
 {
     std::string mimeType;
@@ -50,18 +160,71 @@ void Book::loadData(const char* data, size_t length, const std::string_view& tex
 void Book::load(const std::string_view& content, const std::string_view& baseUrl, const std::string_view& userStyle)
 {
     m_document.reset();
-    m_heap = std::make_unique<Heap>(1024 * 25);
+    m_heap.reset();
+    m_heap = m_heapResource->createHeap(content.size(), m_heapSizeHint);
+    m_stage = BookStage::Parsing;
+    m_error = BookError::None;
 
-    m_document = HTMLDocument::create(this);
-    m_document->setBaseUrl(baseUrl);
-    m_document->load(content);
-    m_document->addStyleSheet(userStyle);
+    try {
+        m_document = HTMLDocument::create(this);
+        m_document->setBaseUrl(baseUrl);
+        m_document->load(content);
+        m_document->addStyleSheet(userStyle);
+    } catch(const std::bad_alloc&) {
+        fail(BookError::MemoryLimitExceeded);
+    }
 }
 
 void Book::clear()
 {
     m_document.reset();
     m_heap.reset();
+    m_heapResource->release();
+    m_stage = BookStage::Empty;
+    m_error = BookError::None;
+}
+
+void Book::setMemoryResource(std::pmr::memory_resource* resource)
+{
+    clear();
+    auto limit = m_heapResource->limit();
+    m_heapResource = std::make_unique<HeapResource>(resource ? resource : std::pmr::get_default_resource());
+    m_heapResource->setLimit(limit);
+}
+
+void Book::clearStyleSheetCache()
+{
+    CSSStyleSheet::clearCache();
+}
+
+std::pmr::memory_resource* Book::memoryResource() const
+{
+    return m_heapResource->upstream();
+}
+
+void Book::setMemoryLimit(size_t bytes)
+{
+    m_heapResource->setLimit(bytes);
+}
+
+size_t Book::memoryLimit() const
+{
+    return m_heapResource->limit();
+}
+
+void Book::setHeapSizeHint(size_t bytes)
+{
+    m_heapSizeHint = bytes;
+}
+
+size_t Book::heapSizeHint() const
+{
+    return m_heapSizeHint;
+}
+
+size_t Book::heapCapacity() const
+{
+    return m_heapResource->capacity();
 }
 
 bool Book::empty()
@@ -69,8 +232,62 @@ bool Book::empty()
     return !!m_document;
 }
 
+size_t Book::pageCount()
+{
+    if(m_document == nullptr || m_error != BookError::None || viewportHeight() <= 0)
+        return 0;
+    if(m_stage == BookStage::Parsing)
+        m_stage = BookStage::Layout;
+
+    BoxView* view = nullptr;
+    try {
+        view = m_document->layout();
+    } catch(const std::bad_alloc&) {
+        fail(BookError::MemoryLimitExceeded);
+        return 0;
+    }
+
+    return view->pageCount(viewportHeight());
+}
+
 void Book::save(const std::string& filename)
 {
+    std::ofstream output(filename, std::ios::binary);
+    if(!output.is_open())
+        return;
+    save(output);
+}
+
+void Book::save(std::ostream& output)
+{
+    auto count = pageCount();
+    if(m_error != BookError::None)
+        return;
+    m_stage = BookStage::Rendering;
+
+    try {
+        PDFWriter writer(output, this);
+        if(count > 0) {
+            auto view = m_document->layout();
+            for(size_t index = 0; index < count; ++index) {
+                writer.writePage(view, index);
+            }
+        }
+
+        writer.finish();
+    } catch(const std::bad_alloc&) {
+        fail(BookError::MemoryLimitExceeded);
+        return;
+    }
+
+    m_stage = BookStage::Finished;
+}
+
+void Book::fail(BookError error)
+{
+    m_document.reset();
+    m_heap.reset();
+    m_error = error;
 }
 
 void Book::serialize(std::ostream& o) const
@@ -153,16 +153,16 @@ HTMLBodyElement::HTMLBodyElement(Document* document)
 {
 }
 
-void HTMLBodyElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLBodyElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == textAttr) {
-        output << "color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Color, value);
     } else if(name == bgcolorAttr) {
-        output << "background-color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BackgroundColor, value);
     } else if(name == backgroundAttr) {
-        output << "background-image:" << "url(" << value << ')';
+        addAttributeStyle(properties, CSSPropertyID::BackgroundImage, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -171,22 +171,24 @@ HTMLImageElement::HTMLImageElement(Document* document)
 {
 }
 
-void HTMLImageElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLImageElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == widthAttr) {
-        output << "width:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Width, value);
     } else if(name == heightAttr) {
-        output << "height:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Height, value);
     } else if(name == valignAttr) {
-        output << "vertical-align:" << value;
+        addAttributeStyle(properties, CSSPropertyID::VerticalAlign, value);
     } else if(name == borderAttr) {
-        output << "border-width:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BorderWidth, value);
     } else if(name == hspaceAttr) {
-        output << "margin-left:" << value << ';' << "margin-right:" << value;
+        addAttributeStyle(properties, CSSPropertyID::MarginLeft, value);
+        addAttributeStyle(properties, CSSPropertyID::MarginRight, value);
     } else if(name == vspaceAttr) {
-        output << "margin-top:" << value << ';' << "margin-bottom:" << value;
+        addAttributeStyle(properties, CSSPropertyID::MarginTop, value);
+        addAttributeStyle(properties, CSSPropertyID::MarginBottom, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -221,14 +223,14 @@ HTMLFontElement::HTMLFontElement(Document* document)
 {
 }
 
-void HTMLFontElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLFontElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == colorAttr) {
-        output << "color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Color, value);
     } else if(name == faceAttr) {
-        output << "font-family:" << value;
+        addAttributeStyle(properties, CSSPropertyID::FontFamily, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -237,14 +239,14 @@ HTMLHRElement::HTMLHRElement(Document* document)
 {
 }
 
-void HTMLHRElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLHRElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == widthAttr) {
-        output << "width:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Width, value);
     } else if(name == colorAttr) {
-        output << "border-color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BorderColor, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -283,26 +285,26 @@ HTMLTableElement::HTMLTableElement(Document* document)
 {
 }
 
-void HTMLTableElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLTableElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == widthAttr) {
-        output << "width:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Width, value);
     } else if(name == heightAttr) {
-        output << "height:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Height, value);
     } else if(name == valignAttr) {
-        output << "vertical-align:" << value;
+        addAttributeStyle(properties, CSSPropertyID::VerticalAlign, value);
     } else if(name == cellspacingAttr) {
-        output << "border-spacing:" << value;;
+        addAttributeStyle(properties, CSSPropertyID::BorderSpacing, value);
     } else if(name == borderAttr) {
-        output << "border-width:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BorderWidth, value);
     } else if(name == bordercolorAttr) {
-        output << "border-color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BorderColor, value);
     } else if(name == bgcolorAttr) {
-        output << "background-color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BackgroundColor, value);
     } else if(name == backgroundAttr) {
-        output << "background-image:" << "url(" << value << ')';
+        addAttributeStyle(properties, CSSPropertyID::BackgroundImage, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -311,16 +313,16 @@ HTMLTableSectionElement::HTMLTableSectionElement(Document* document, const Globa
 {
 }
 
-void HTMLTableSectionElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLTableSectionElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == heightAttr) {
-        output << "height:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Height, value);
     } else if(name == bgcolorAttr) {
-        output << "background-color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BackgroundColor, value);
     } else if(name == backgroundAttr) {
-        output << "background-image:" << "url(" << value << ')';
+        addAttributeStyle(properties, CSSPropertyID::BackgroundImage, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -329,12 +331,12 @@ HTMLTableCaptionElement::HTMLTableCaptionElement(Document* document)
 {
 }
 
-void HTMLTableCaptionElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLTableCaptionElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == widthAttr) {
-        output << "width:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Width, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -343,16 +345,16 @@ HTMLTableRowElement::HTMLTableRowElement(Document* document)
 {
 }
 
-void HTMLTableRowElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLTableRowElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == heightAttr) {
-        output << "height:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Height, value);
     } else if(name == bgcolorAttr) {
-        output << "background-color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BackgroundColor, value);
     } else if(name == backgroundAttr) {
-        output << "background-image:" << "url(" << value << ')';
+        addAttributeStyle(properties, CSSPropertyID::BackgroundImage, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -361,18 +363,18 @@ HTMLTableColElement::HTMLTableColElement(Document* document, const GlobalString&
 {
 }
 
-void HTMLTableColElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLTableColElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == widthAttr) {
-        output << "width:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Width, value);
     } else if(name == heightAttr) {
-        output << "height:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Height, value);
     } else if(name == bgcolorAttr) {
-        output << "background-color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BackgroundColor, value);
     } else if(name == backgroundAttr) {
-        output << "background-image:" << "url(" << value << ')';
+        addAttributeStyle(properties, CSSPropertyID::BackgroundImage, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -399,18 +401,18 @@ HTMLTableCellElement::HTMLTableCellElement(Document* document, const GlobalStrin
 {
 }
 
-void HTMLTableCellElement::collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const
+void HTMLTableCellElement::collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const
 {
     if(name == widthAttr) {
-        output << "width:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Width, value);
     } else if(name == heightAttr) {
-        output << "height:" << value;
+        addAttributeStyle(properties, CSSPropertyID::Height, value);
     } else if(name == bgcolorAttr) {
-        output << "background-color:" << value;
+        addAttributeStyle(properties, CSSPropertyID::BackgroundColor, value);
     } else if(name == backgroundAttr) {
-        output << "background-image:" << "url(" << value << ')';
+        addAttributeStyle(properties, CSSPropertyID::BackgroundImage, value);
     } else {
-        HTMLElement::collectAttributeStyle(output, name, value);
+        HTMLElement::collectAttributeStyle(properties, name, value);
     }
 }
 
@@ -23,14 +23,14 @@ class HTMLBodyElement final : public HTMLElement {
 public:
     HTMLBodyElement(Document* document);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
 };
 
 class HTMLImageElement final : public HTMLElement {
 public:
     HTMLImageElement(Document* document);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
     const HeapString& src() const;
     const HeapString& altText() const;
     RefPtr<Image> image() const;
@@ -42,14 +42,14 @@ class HTMLFontElement final : public HTMLElement {
 public:
     HTMLFontElement(Document* document);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
 };
 
 class HTMLHRElement final : public HTMLElement {
 public:
     HTMLHRElement(Document* document);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
 };
 
 class HTMLLIElement final : public HTMLElement {
@@ -70,35 +70,35 @@ class HTMLTableElement final : public HTMLElement {
 public:
     HTMLTableElement(Document* document);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
 };
 
 class HTMLTableSectionElement final : public HTMLElement {
 public:
     HTMLTableSectionElement(Document* document, const GlobalString& tagName);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
 };
 
 class HTMLTableCaptionElement final : public HTMLElement {
 public:
     HTMLTableCaptionElement(Document* document);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
 };
 
 class HTMLTableRowElement final : public HTMLElement {
 public:
     HTMLTableRowElement(Document* document);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
 };
 
 class HTMLTableColElement final : public HTMLElement {
 public:
     HTMLTableColElement(Document* document, const GlobalString& tagName);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
     unsigned span() const;
 
     Box* createBox(const RefPtr<BoxStyle>& style) final;
@@ -108,7 +108,7 @@ class HTMLTableCellElement final : public HTMLElement {
 public:
     HTMLTableCellElement(Document* document, const GlobalString& tagName);
 
-    void collectAttributeStyle(std::stringstream& output, const GlobalString& name, const HeapString& value) const final;
+    void collectAttributeStyle(CSSPropertyList& properties, const GlobalString& name, const HeapString& value) const final;
     unsigned colSpan() const;
     unsigned rowSpan() const;
 
@@ -3,6 +3,7 @@
 #include "document.h"
 
 #include <cassert>
+#include <bit>
 
 namespace htmlbook {
 
@@ -55,30 +56,144 @@ Heap* BoxStyle::heap() const
 BoxStyle::~BoxStyle() = default;
 
 BoxStyle::BoxStyle(Node* node, PseudoType pseudoType, Display display)
-    : m_node(node), m_properties(node->heap()), m_pseudoType(pseudoType), m_display(display)
+    : m_node(node), m_values(node->heap()), m_inheritedData(defaultInheritedData()), m_pseudoType(pseudoType), m_display(display)
 {
 }
 
+RefPtr<BoxStyle::InheritedData> BoxStyle::InheritedData::create(Heap* heap)
+{
+    return adoptPtr(new (heap) InheritedData);
+}
+
+RefPtr<BoxStyle::InheritedData> BoxStyle::InheritedData::clone(Heap* heap) const
+{
+    auto data = create(heap);
+    data->values = values;
+    data->fontFace = fontFace;
+    data->direction = direction;
+    data->visibility = visibility;
+    data->textAlign = textAlign;
+    data->whiteSpace = whiteSpace;
+    data->fontStyle = fontStyle;
+    data->fontVariant = fontVariant;
+    data->fontSize = fontSize;
+    data->fontWeight = fontWeight;
+    data->color = color;
+    return data;
+}
+
+static void hashCombine(size_t& seed, size_t value)
+{
+    seed ^= value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+}
+
+size_t BoxStyle::InheritedData::hash() const
+{
+    size_t seed = 0;
+    for(auto& value : values)
+        hashCombine(seed, std::hash<CSSValue*>()(value.get()));
+    hashCombine(seed, static_cast<size_t>(direction));
+    hashCombine(seed, static_cast<size_t>(visibility));
+    hashCombine(seed, static_cast<size_t>(textAlign));
+    hashCombine(seed, static_cast<size_t>(whiteSpace));
+    hashCombine(seed, static_cast<size_t>(fontStyle));
+    hashCombine(seed, static_cast<size_t>(fontVariant));
+    hashCombine(seed, std::hash<float>()(fontSize));
+    hashCombine(seed, static_cast<size_t>(fontWeight));
+    hashCombine(seed, color.value());
+    return seed;
+}
+
+bool BoxStyle::InheritedData::equals(const InheritedData& data) const
+{
+    return values == data.values
+        && direction == data.direction
+        && visibility == data.visibility
+        && textAlign == data.textAlign
+        && whiteSpace == data.whiteSpace
+        && fontStyle == data.fontStyle
+        && fontVariant == data.fontVariant
+        && fontSize == data.fontSize
+        && fontWeight == data.fontWeight
+        && color.value() == data.color.value();
+}
+
+BoxStyle::InheritedData::~InheritedData() = default;
+
+const RefPtr<BoxStyle::InheritedData>& BoxStyle::defaultInheritedData()
+{
+    static char buffer[256];
+    static Heap heap(buffer, sizeof(buffer));
+    static auto data = [] {
+        auto data = InheritedData::create(&heap);
+        data->makeStatic();
+        return data;
+    }();
+
+    return data;
+}
+
+BoxStyle::InheritedData& BoxStyle::mutableInheritedData()
+{
+    if(!m_inheritedData->hasOneRefCount())
+        m_inheritedData = m_inheritedData->clone(heap());
+    return *m_inheritedData;
+}
+
+static int inheritedPropertyIndex(CSSPropertyID id)
+{
+    switch(id) {
+    case CSSPropertyID::Color:
+        return 0;
+    case CSSPropertyID::Direction:
+        return 1;
+    case CSSPropertyID::FontFamily:
+        return 2;
+    case CSSPropertyID::FontSize:
+        return 3;
+    case CSSPropertyID::FontStyle:
+        return 4;
+    case CSSPropertyID::FontVariant:
+        return 5;
+    case CSSPropertyID::FontWeight:
+        return 6;
+    case CSSPropertyID::TextAlign:
+        return 7;
+    case CSSPropertyID::Visibility:
+        return 8;
+    case CSSPropertyID::WhiteSpace:
+        return 9;
+    default:
+        return -1;
+    }
+}
+
 RefPtr<FontFace> BoxStyle::fontFace() const
 {
-    if(!m_fontFace.empty())
-        return m_fontFace;
-    auto italic = (m_fontStyle == FontStyle::Italic || m_fontStyle == FontStyle::Oblique);
-    auto smallCaps = (m_fontVariant == FontVariant::SmallCaps);
-    auto fontFamily = get(CSSPropertyID::FontFamily);
-    if(fontFamily && is<CSSListValue>(*fontFamily)) {
-        for(auto& value : to<CSSListValue>(*fontFamily).values()) {
-            auto& family = to<CSSStringValue>(*value);
-            m_fontFace = document()->getFontFace(family.value(), italic, smallCaps, m_fontWeight);
-            if(m_fontFace.empty())
-                continue;
-            return m_fontFace;
+    auto& data = *m_inheritedData;
+    if(!data.fontFace.empty())
+        return data.fontFace;
+    auto italic = (data.fontStyle == FontStyle::Italic || data.fontStyle == FontStyle::Oblique);
+    auto smallCaps = (data.fontVariant == FontVariant::SmallCaps);
+    auto fetch = [&]() -> RefPtr<FontFace> {
+        auto fontFamily = get(CSSPropertyID::FontFamily);
+        if(fontFamily && is<CSSListValue>(*fontFamily)) {
+            for(auto& value : to<CSSListValue>(*fontFamily).values()) {
+                auto& family = to<CSSStringValue>(*value);
+                if(auto face = document()->getFontFace(family.value(), italic, smallCaps, data.fontWeight)) {
+                    return face;
+                }
+            }
         }
-    }
 
-    static const std::string family("sans-serif");
-    m_fontFace = document()->getFontFace(family, italic, smallCaps, m_fontWeight);
-    return m_fontFace;
+        static const std::string family("sans-serif");
+        return document()->getFontFace(family, italic, smallCaps, data.fontWeight);
+    };
+
+    auto face = fetch();
+    if(!data.isStatic())
+        m_inheritedData->fontFace = face;
+    return face;
 }
 
 Length BoxStyle::left() const
@@ -261,7 +376,7 @@ Color BoxStyle::borderLeftColor() const
 {
     auto value = get(CSSPropertyID::BorderLeftColor);
     if(value == nullptr)
-        return m_color;
+        return m_inheritedData->color;
     return convertColor(*value);
 }
 
@@ -269,7 +384,7 @@ Color BoxStyle::borderRightColor() const
 {
     auto value = get(CSSPropertyID::BorderRightColor);
     if(value == nullptr)
-        return m_color;
+        return m_inheritedData->color;
     return convertColor(*value);
 }
 
@@ -277,7 +392,7 @@ Color BoxStyle::borderTopColor() const
 {
     auto value = get(CSSPropertyID::BorderTopColor);
     if(value == nullptr)
-        return m_color;
+        return m_inheritedData->color;
     return convertColor(*value);
 }
 
@@ -285,7 +400,7 @@ Color BoxStyle::borderBottomColor() const
 {
     auto value = get(CSSPropertyID::BorderBottomColor);
     if(value == nullptr)
-        return m_color;
+        return m_inheritedData->color;
     return convertColor(*value);
 }
 
@@ -680,7 +795,7 @@ Color BoxStyle::textDecorationColor() const
 {
     auto value = get(CSSPropertyID::TextDecorationColor);
     if(value == nullptr)
-        return m_color;
+        return m_inheritedData->color;
     return convertColor(*value);
 }
 
@@ -957,7 +1072,7 @@ Color BoxStyle::outlineColor() const
 {
     auto value = get(CSSPropertyID::OutlineColor);
     if(value == nullptr)
-        return m_color;
+        return m_inheritedData->color;
     return convertColor(*value);
 }
 
@@ -981,7 +1096,7 @@ Color BoxStyle::columnRuleColor() const
 {
     auto value = get(CSSPropertyID::OutlineColor);
     if(value == nullptr)
-        return m_color;
+        return m_inheritedData->color;
     return convertColor(*value);
 }
 
@@ -1098,16 +1213,39 @@ const HeapString& BoxStyle::getQuote(bool open, size_t depth) const
     return to<CSSStringValue>(*quote).value();
 }
 
-RefPtr<CSSValue> BoxStyle::get(CSSPropertyID id) const
+size_t BoxStyle::valueIndex(size_t word, uint64_t bit) const
 {
-    auto it = m_properties.find(id);
-    if(it == m_properties.end())
-        return nullptr;
-    return it->second;
+    size_t index = std::popcount(m_propertyBits[word] & (bit - 1));
+    for(size_t i = 0; i < word; ++i)
+        index += std::popcount(m_propertyBits[i]);
+    return index;
+}
+
+CSSValue* BoxStyle::get(CSSPropertyID id) const
+{
+    auto index = static_cast<size_t>(id);
+    auto word = index / 64;
+    auto bit = uint64_t(1) << (index % 64);
+    if(m_propertyBits[word] & bit)
+        return m_values[valueIndex(word, bit)].get();
+    if(auto inheritedIndex = inheritedPropertyIndex(id); inheritedIndex != -1)
+        return m_inheritedData->values[inheritedIndex].get();
+    return nullptr;
+}
+
+bool BoxStyle::has(CSSPropertyID id) const
+{
+    return get(id);
 }
 
 void BoxStyle::set(CSSPropertyID id, RefPtr<CSSValue> value)
 {
+    auto inheritedIndex = inheritedPropertyIndex(id);
+    if(inheritedIndex != -1 && id != CSSPropertyID::FontSize && id != CSSPropertyID::FontWeight
+        && m_inheritedData->values[inheritedIndex] == value) {
+        return;
+    }
+
     switch(id) {
     case CSSPropertyID::Display:
         m_display = convertDisplay(*value);
@@ -1125,46 +1263,66 @@ void BoxStyle::set(CSSPropertyID id, RefPtr<CSSValue> value)
         m_overflow = convertOverflow(*value);
         break;
     case CSSPropertyID::Direction:
-        m_direction = convertDirection(*value);
+        mutableInheritedData().direction = convertDirection(*value);
         break;
     case CSSPropertyID::Visibility:
-        m_visibility = convertVisibility(*value);
+        mutableInheritedData().visibility = convertVisibility(*value);
         break;
     case CSSPropertyID::BoxSizing:
         m_boxSizing = convertBoxSizing(*value);
         break;
     case CSSPropertyID::TextAlign:
-        m_textAlign = convertTextAlign(*value);
+        mutableInheritedData().textAlign = convertTextAlign(*value);
         break;
     case CSSPropertyID::WhiteSpace:
-        m_whiteSpace = convertWhiteSpace(*value);
+        mutableInheritedData().whiteSpace = convertWhiteSpace(*value);
         break;
     case CSSPropertyID::Color:
-        m_color = convertColor(*value);
+        mutableInheritedData().color = convertColor(*value);
         break;
     case CSSPropertyID::FontSize:
-        m_fontSize = convertFontSize(*value);
+        mutableInheritedData().fontSize = convertFontSize(*value);
         break;
     case CSSPropertyID::FontStyle:
-        m_fontStyle = convertFontStyle(*value);
-        m_fontFace.clear();
+        mutableInheritedData().fontStyle = convertFontStyle(*value);
+        m_inheritedData->fontFace.clear();
         break;
     case CSSPropertyID::FontVariant:
-        m_fontVariant = convertFontVariant(*value);
-        m_fontFace.clear();
+        mutableInheritedData().fontVariant = convertFontVariant(*value);
+        m_inheritedData->fontFace.clear();
         break;
     case CSSPropertyID::FontWeight:
-        m_fontWeight = convertFontWeight(*value);
-        m_fontFace.clear();
+        mutableInheritedData().fontWeight = convertFontWeight(*value);
+        m_inheritedData->fontFace.clear();
         break;
     case CSSPropertyID::FontFamily:
-        m_fontFace.clear();
+        mutableInheritedData().fontFace.clear();
         break;
     default:
         break;
     }
 
-    m_properties.insert_or_assign(id, std::move(value));
+    if(inheritedIndex != -1) {
+        mutableInheritedData().values[inheritedIndex] = std::move(value);
+        return;
+    }
+
+    setValue(id, std::move(value));
+}
+
+void BoxStyle::setValue(CSSPropertyID id, RefPtr<CSSValue> value)
+{
+    auto index = static_cast<size_t>(id);
+    auto word = index / 64;
+    auto bit = uint64_t(1) << (index % 64);
+    auto it = m_values.begin() + valueIndex(word, bit);
+    if(m_propertyBits[word] & bit) {
+        *it = std::move(value);
+        return;
+    }
+
+    m_propertyBits[word] |= bit;
+    m_values.insert(it, std::move(value));
 }
 
 void BoxStyle::remove(CSSPropertyID id)
@@ -1186,43 +1344,55 @@ void BoxStyle::remove(CSSPropertyID id)
         m_overflow = Overflow::Visible;
         break;
     case CSSPropertyID::Visibility:
-        m_visibility = Visibility::Visible;
+        mutableInheritedData().visibility = Visibility::Visible;
         break;
     case CSSPropertyID::BoxSizing:
         m_boxSizing = BoxSizing::ContentBox;
         break;
     case CSSPropertyID::TextAlign:
-        m_textAlign = TextAlign::Left;
+        mutableInheritedData().textAlign = TextAlign::Left;
         break;
     case CSSPropertyID::WhiteSpace:
-        m_whiteSpace = WhiteSpace::Normal;
+        mutableInheritedData().whiteSpace = WhiteSpace::Normal;
         break;
     case CSSPropertyID::Color:
-        m_color = Color::Black;
+        mutableInheritedData().color = Color::Black;
         break;
     case CSSPropertyID::FontSize:
-        m_fontSize = 12.0;
+        mutableInheritedData().fontSize = 12.0;
         break;
     case CSSPropertyID::FontStyle:
-        m_fontStyle = FontStyle::Normal;
-        m_fontFace.clear();
+        mutableInheritedData().fontStyle = FontStyle::Normal;
+        m_inheritedData->fontFace.clear();
         break;
     case CSSPropertyID::FontVariant:
-        m_fontVariant = FontVariant::Normal;
-        m_fontFace.clear();
+        mutableInheritedData().fontVariant = FontVariant::Normal;
+        m_inheritedData->fontFace.clear();
         break;
     case CSSPropertyID::FontWeight:
-        m_fontWeight = 400;
-        m_fontFace.clear();
+        mutableInheritedData().fontWeight = 400;
+        m_inheritedData->fontFace.clear();
         break;
     case CSSPropertyID::FontFamily:
-        m_fontFace.clear();
+        mutableInheritedData().fontFace.clear();
         break;
     default:
         break;
     }
 
-    m_properties.erase(id);
+    if(auto inheritedIndex = inheritedPropertyIndex(id); inheritedIndex != -1) {
+        if(m_inheritedData->values[inheritedIndex])
+            mutableInheritedData().values[inheritedIndex] = nullptr;
+        return;
+    }
+
+    auto index = static_cast<size_t>(id);
+    auto word = index / 64;
+    auto bit = uint64_t(1) << (index % 64);
+    if(!(m_propertyBits[word] & bit))
+        return;
+    m_values.erase(m_values.begin() + valueIndex(word, bit));
+    m_propertyBits[word] &= ~bit;
 }
 
 float BoxStyle::exFontSize() const
@@ -1342,9 +1512,9 @@ float BoxStyle::convertFontSize(const CSSValue& value) const
         case CSSValueID::XxxLarge:
             return 8.0;
         case CSSValueID::Smaller:
-            return m_fontSize / 1.2;
+            return m_inheritedData->fontSize / 1.2;
         case CSSValueID::Larger:
-            return m_fontSize * 1.2;
+            return m_inheritedData->fontSize * 1.2;
         default:
             assert(false);
         }
@@ -1352,7 +1522,7 @@ float BoxStyle::convertFontSize(const CSSValue& value) const
 
     if(is<CSSPercentValue>(value)) {
         auto& percent = to<CSSPercentValue>(value);
-        return percent.value() * m_fontSize / 100.0;
+        return percent.value() * m_inheritedData->fontSize / 100.0;
     }
 
     return convertLengthValue(value);
@@ -1464,7 +1634,7 @@ Color BoxStyle::convertColor(const CSSValue& value) const
     if(is<CSSIdentValue>(value)) {
         auto& ident = to<CSSIdentValue>(value);
         assert(ident.value() == CSSValueID::CurrentColor);
-        return m_color;
+        return m_inheritedData->color;
     }
 
     auto& color = to<CSSColorValue>(value);
@@ -1849,34 +2019,38 @@ float BoxStyle::convertNumber(const CSSValue& value)
 
 void BoxStyle::inheritFrom(const BoxStyle& parentStyle)
 {
-    m_fontFace = parentStyle.fontFace();
-    m_direction = parentStyle.direction();
-    m_visibility = parentStyle.visibility();
-    m_textAlign = parentStyle.textAlign();
-    m_whiteSpace = parentStyle.whiteSpace();
-    m_color = parentStyle.color();
-    m_fontSize = parentStyle.fontSize();
-    m_fontStyle = parentStyle.fontStyle();
-    m_fontVariant = parentStyle.fontVariant();
-    m_fontWeight = parentStyle.fontWeight();
-    for(auto& [id, value] : parentStyle.properties()) {
-        switch(id) {
-        case CSSPropertyID::Direction:
-        case CSSPropertyID::Visibility:
-        case CSSPropertyID::TextAlign:
-        case CSSPropertyID::WhiteSpace:
-        case CSSPropertyID::Color:
-        case CSSPropertyID::FontSize:
-        case CSSPropertyID::FontStyle:
-        case CSSPropertyID::FontVariant:
-        case CSSPropertyID::FontWeight:
-        case CSSPropertyID::FontFamily:
-            m_properties.insert_or_assign(id, value);
-            break;
-        default:
-            break;
-        }
-    }
+    m_inheritedData = parentStyle.m_inheritedData;
+}
+
+size_t BoxStyle::hash() const
+{
+    size_t seed = m_inheritedData->hash();
+    for(auto bits : m_propertyBits)
+        hashCombine(seed, bits);
+    for(auto& value : m_values)
+        hashCombine(seed, std::hash<CSSValue*>()(value.get()));
+    hashCombine(seed, static_cast<size_t>(m_pseudoType));
+    hashCombine(seed, static_cast<size_t>(m_display));
+    hashCombine(seed, static_cast<size_t>(m_position));
+    hashCombine(seed, static_cast<size_t>(m_floating));
+    hashCombine(seed, static_cast<size_t>(m_clear));
+    hashCombine(seed, static_cast<size_t>(m_overflow));
+    hashCombine(seed, static_cast<size_t>(m_boxSizing));
+    return seed;
+}
+
+bool BoxStyle::equals(const BoxStyle& style) const
+{
+    return m_propertyBits == style.m_propertyBits
+        && m_values == style.m_values
+        && m_pseudoType == style.m_pseudoType
+        && m_display == style.m_display
+        && m_position == style.m_position
+        && m_floating == style.m_floating
+        && m_clear == style.m_clear
+        && m_overflow == style.m_overflow
+        && m_boxSizing == style.m_boxSizing
+        && (m_inheritedData == style.m_inheritedData || m_inheritedData->equals(*style.m_inheritedData));
 }
 
 } // namespace htmlbook
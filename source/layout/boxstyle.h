@@ -438,13 +438,12 @@ public:
 
     Node* node() const { return m_node; }
     PseudoType pseudoType() const { return m_pseudoType; }
-    const CSSPropertyMap& properties() const { return m_properties; }
     RefPtr<FontFace> fontFace() const;
 
-    float fontSize() const { return m_fontSize; }
-    int fontWeight() const { return m_fontWeight; }
-    FontStyle fontStyle() const { return m_fontStyle; }
-    FontVariant fontVariant() const { return m_fontVariant; }
+    float fontSize() const { return m_inheritedData->fontSize; }
+    int fontWeight() const { return m_inheritedData->fontWeight; }
+    FontStyle fontStyle() const { return m_inheritedData->fontStyle; }
+    FontVariant fontVariant() const { return m_inheritedData->fontVariant; }
 
     void setDisplay(Display display) { m_display = display; }
     void setPosition(Position position) { m_position = position; }
@@ -455,9 +454,9 @@ public:
     Float floating() const { return m_floating; }
     Clear clear() const { return m_clear; }
     Overflow overflow() const { return m_overflow; }
-    Direction direction() const { return m_direction; }
-    Visibility visibility() const { return m_visibility; }
-    const Color& color() const { return m_color; }
+    Direction direction() const { return m_inheritedData->direction; }
+    Visibility visibility() const { return m_inheritedData->visibility; }
+    const Color& color() const { return m_inheritedData->color; }
 
     Length left() const;
     Length right() const;
@@ -520,13 +519,13 @@ public:
     float borderHorizontalSpacing() const;
     float borderVerticalSpacing() const;
 
-    TextAlign textAlign() const { return m_textAlign; }
+    TextAlign textAlign() const { return m_inheritedData->textAlign; }
     TextTransform textTransform() const;
     TextOverflow textOverflow() const;
     TextDecorationLine textDecorationLine() const;
     TextDecorationStyle textDecorationStyle() const;
     Color textDecorationColor() const;
-    WhiteSpace whiteSpace() const { return m_whiteSpace; }
+    WhiteSpace whiteSpace() const { return m_inheritedData->whiteSpace; }
     LineBreak lineBreak() const;
     WordBreak wordBreak() const;
     WordWrap wordWrap() const;
@@ -569,18 +568,19 @@ public:
     bool isDisplayFlex() const { return m_display == Display::Flex || m_display == Display::InlineFlex; }
     bool isFloating() const { return m_floating == Float::Left || m_floating == Float::Right; }
     bool isPositioned() const { return m_position == Position::Absolute || m_position == Position::Fixed; }
-    bool isLeftToRightDirection() const { return m_direction == Direction::Ltr; }
-    bool isRightToLeftDirection() const { return m_direction == Direction::Rtl; }
+    bool isLeftToRightDirection() const { return m_inheritedData->direction == Direction::Ltr; }
+    bool isRightToLeftDirection() const { return m_inheritedData->direction == Direction::Rtl; }
     bool isClearLeft() const { return m_clear == Clear::Left || m_clear == Clear::Both; }
     bool isClearRight() const { return m_clear == Clear::Right || m_clear == Clear::Both; }
     bool hasTransform() const;
 
     const HeapString& getQuote(bool open, size_t depth) const;
 
-    RefPtr<CSSValue> get(CSSPropertyID id) const;
+    CSSValue* get(CSSPropertyID id) const;
     void set(CSSPropertyID id, RefPtr<CSSValue> value);
     void remove(CSSPropertyID id);
-    bool has(CSSPropertyID id) const { return get(id); }
+    bool has(CSSPropertyID id) const;
+    void reserve(size_t count) { m_values.reserve(count); }
 
     float exFontSize() const;
     float chFontSize() const;
@@ -629,29 +629,58 @@ public:
 
     void inheritFrom(const BoxStyle& parentStyle);
 
+    size_t hash() const;
+    bool equals(const BoxStyle& style) const;
+
     ~BoxStyle();
 
 private:
+    static constexpr size_t kNumInheritedProperties = 10;
+
+    class InheritedData : public HeapMember, public RefCounted<InheritedData> {
+    public:
+        static RefPtr<InheritedData> create(Heap* heap);
+        RefPtr<InheritedData> clone(Heap* heap) const;
+
+        size_t hash() const;
+        bool equals(const InheritedData& data) const;
+
+        ~InheritedData();
+
+        std::array<RefPtr<CSSValue>, kNumInheritedProperties> values;
+        RefPtr<FontFace> fontFace;
+        Direction direction{Direction::Ltr};
+        Visibility visibility{Visibility::Visible};
+        TextAlign textAlign{TextAlign::Left};
+        WhiteSpace whiteSpace{WhiteSpace::Normal};
+        FontStyle fontStyle{FontStyle::Normal};
+        FontVariant fontVariant{FontVariant::Normal};
+        float fontSize{12.0};
+        int fontWeight{400};
+        Color color{Color::Black};
+
+    private:
+        InheritedData() = default;
+    };
+
     BoxStyle(Node* node, PseudoType pseudoType, Display display);
+    size_t valueIndex(size_t word, uint64_t bit) const;
+    void setValue(CSSPropertyID id, RefPtr<CSSValue> value);
+    InheritedData& mutableInheritedData();
+
+    static const RefPtr<InheritedData>& defaultInheritedData();
+
     Node* m_node;
-    CSSPropertyMap m_properties;
-    mutable RefPtr<FontFace> m_fontFace;
+    CSSPropertyBits m_propertyBits{};
+    std::pmr::vector<RefPtr<CSSValue>> m_values;
+    RefPtr<InheritedData> m_inheritedData;
     PseudoType m_pseudoType;
     Display m_display;
     Position m_position{Position::Static};
     Float m_floating{Float::None};
     Clear m_clear{Clear::None};
     Overflow m_overflow{Overflow::Visible};
-    Direction m_direction{Direction::Ltr};
-    Visibility m_visibility{Visibility::Visible};
     BoxSizing m_boxSizing{BoxSizing::ContentBox};
-    TextAlign m_textAlign{TextAlign::Left};
-    WhiteSpace m_whiteSpace{WhiteSpace::Normal};
-    FontStyle m_fontStyle{FontStyle::Normal};
-    FontVariant m_fontVariant{FontVariant::Normal};
-    float m_fontSize{12.0};
-    int m_fontWeight{400};
-    Color m_color{Color::Black};
 };
 
 } // namespace htmlbook
@@ -1,6 +1,8 @@
 #include "boxview.h"
 #include "document.h"
 
+#include <cmath>
+
 namespace htmlbook {
 
 BoxView::BoxView(Document* document, const RefPtr<BoxStyle>& style)
@@ -37,4 +39,12 @@ void BoxView::layout()
     layoutPositionedBoxes();
 }
 
+size_t BoxView::pageCount(float pageHeight) const
+{
+    float height = 0;
+    for(auto child = firstBoxFrame(); child; child = child->nextBoxFrame())
+        height = std::max(height, child->y() + child->height());
+    return std::max(1.f, std::ceil(height / pageHeight));
+}
+
 } // namespace htmlbook
@@ -16,6 +16,8 @@ public:
     void computeHeight(float& y, float& height, float& marginTop, float& marginBottom) const final;
     void layout() final;
 
+    size_t pageCount(float pageHeight) const;
+
     const char* name() const final { return "BoxView"; }
 };
 
@@ -0,0 +1,160 @@
+#include "htmlbook.h"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define HTMLBOOK_HAS_MMAP 1
+#endif
+
+namespace htmlbook {
+
+constexpr size_t kPageSize = 1024 * 4;
+constexpr size_t kHugePageSize = 1024 * 1024 * 2;
+constexpr size_t kMinMappedSize = 1024 * 256;
+
+constexpr size_t roundUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+#ifdef HTMLBOOK_HAS_MMAP
+
+static size_t mappedSize(size_t bytes)
+{
+    if(bytes >= kHugePageSize)
+        return roundUp(bytes, kHugePageSize);
+    return roundUp(bytes, kPageSize);
+}
+
+void* HugePageResource::do_allocate(size_t bytes, size_t alignment)
+{
+    if(bytes < kMinMappedSize || alignment > kPageSize)
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    auto length = mappedSize(bytes);
+    if(length < kHugePageSize) {
+        auto data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(data == MAP_FAILED)
+            throw std::bad_alloc();
+        return data;
+    }
+
+    auto data = static_cast<char*>(mmap(nullptr, length + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if(data == MAP_FAILED)
+        throw std::bad_alloc();
+    auto aligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(data), kHugePageSize));
+    if(aligned > data)
+        munmap(data, aligned - data);
+    if(auto tail = (data + length + kHugePageSize) - (aligned + length))
+        munmap(aligned + length, tail);
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+
+void HugePageResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    if(bytes < kMinMappedSize || alignment > kPageSize) {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        return;
+    }
+
+    munmap(p, mappedSize(bytes));
+}
+
+#else
+
+void* HugePageResource::do_allocate(size_t bytes, size_t alignment)
+{
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void HugePageResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+#endif
+
+bool HugePageResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return dynamic_cast<const HugePageResource*>(&other);
+}
+
+constexpr size_t kMinBlockSize = 1024 * 4;
+
+static size_t sizeClass(size_t bytes)
+{
+    return std::bit_width(std::max(bytes, kMinBlockSize) - 1);
+}
+
+BlockPoolResource::BlockPoolResource(size_t maxRetainedBytes, std::pmr::memory_resource* upstream)
+    : m_maxRetainedBytes(maxRetainedBytes), m_upstream(upstream)
+{
+}
+
+BlockPoolResource::~BlockPoolResource()
+{
+    release();
+}
+
+void BlockPoolResource::release()
+{
+    for(size_t index = 0; index < kNumSizeClasses; ++index) {
+        auto block = m_freeBlocks[index];
+        while(block) {
+            auto next = block->next;
+            m_upstream->deallocate(block, size_t(1) << index, alignof(std::max_align_t));
+            block = next;
+        }
+
+        m_freeBlocks[index] = nullptr;
+    }
+
+    m_retainedBytes = 0;
+}
+
+void* BlockPoolResource::do_allocate(size_t bytes, size_t alignment)
+{
+    auto index = sizeClass(bytes);
+    if(index >= kNumSizeClasses || alignment > alignof(std::max_align_t))
+        return m_upstream->allocate(bytes, alignment);
+    if(auto block = m_freeBlocks[index]) {
+        m_freeBlocks[index] = block->next;
+        m_retainedBytes -= size_t(1) << index;
+        return block;
+    }
+
+    return m_upstream->allocate(size_t(1) << index, alignof(std::max_align_t));
+}
+
+void BlockPoolResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    auto index = sizeClass(bytes);
+    if(index >= kNumSizeClasses || alignment > alignof(std::max_align_t)) {
+        m_upstream->deallocate(p, bytes, alignment);
+        return;
+    }
+
+    auto size = size_t(1) << index;
+    if(m_retainedBytes + size > m_maxRetainedBytes) {
+        m_upstream->deallocate(p, size, alignof(std::max_align_t));
+        return;
+    }
+
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = m_freeBlocks[index];
+    m_freeBlocks[index] = block;
+    m_retainedBytes += size;
+}
+
+bool BlockPoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+} // namespace htmlbook
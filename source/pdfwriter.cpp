@@ -0,0 +1,401 @@
+#include "pdfwriter.h"
+#include "htmlbook.h"
+#include "boxview.h"
+#include "replacedbox.h"
+#include "inlinebox.h"
+#include "textbox.h"
+#include "resource.h"
+
+#include <cmath>
+#include <iomanip>
+
+namespace htmlbook {
+
+PDFWriter::PDFWriter(std::ostream& output, const Book* book)
+    : m_output(output), m_book(book)
+{
+    m_content.imbue(std::locale::classic());
+    m_content << std::fixed << std::setprecision(3);
+
+    m_objectOffsets.resize(4, 0);
+    write("%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+}
+
+void PDFWriter::writePage(const BoxView* view, size_t pageIndex)
+{
+    auto pageWidth = m_book->pageWidth();
+    auto pageHeight = m_book->pageHeight();
+    auto& margins = m_book->pageMargins();
+
+    m_windowTop = pageIndex * m_book->viewportHeight();
+    m_windowBottom = m_windowTop + m_book->viewportHeight();
+
+    m_content << "q\n";
+    m_content << margins.left() << ' ' << margins.bottom() << ' ' << m_book->viewportWidth() << ' ' << m_book->viewportHeight() << " re W n\n";
+    m_content << "1 0 0 -1 " << margins.left() << ' ' << pageHeight - margins.top() + m_windowTop << " cm\n";
+    paintBox(view, 0, 0);
+    m_content << "Q\n";
+
+    auto content = m_content.str();
+    m_content.str(std::string());
+
+    auto contentObject = allocateObject();
+    writeStream(contentObject, std::string(), content.data(), content.length());
+
+    std::ostringstream page;
+    page.imbue(std::locale::classic());
+    page << "<< /Type /Page /Parent 2 0 R";
+    page << " /MediaBox [0 0 " << pageWidth << ' ' << pageHeight << ']';
+    page << " /Contents " << contentObject << " 0 R";
+    page << " /Resources << /ProcSet [/PDF /Text /ImageC]";
+    if(!m_pageFonts.empty()) {
+        page << " /Font <<";
+        for(auto& [object, name] : m_pageFonts)
+            page << " /" << name << ' ' << object << " 0 R";
+        page << " >>";
+    }
+
+    if(!m_pageImages.empty()) {
+        page << " /XObject <<";
+        for(auto& [object, name] : m_pageImages)
+            page << " /" << name << ' ' << object << " 0 R";
+        page << " >>";
+    }
+
+    page << " >> >>\n";
+
+    auto pageObject = allocateObject();
+    beginObject(pageObject);
+    write(page.str());
+    endObject();
+
+    m_pageObjects.push_back(pageObject);
+    m_pageFonts.clear();
+    m_pageImages.clear();
+    m_output.flush();
+}
+
+void PDFWriter::finish()
+{
+    m_lastSkippedChild.clear();
+
+    std::ostringstream pages;
+    pages << "<< /Type /Pages /Kids [";
+    for(auto object : m_pageObjects)
+        pages << ' ' << object << " 0 R";
+    pages << " ] /Count " << m_pageObjects.size() << " >>\n";
+
+    beginObject(2);
+    write(pages.str());
+    endObject();
+
+    beginObject(1);
+    write("<< /Type /Catalog /Pages 2 0 R >>\n");
+    endObject();
+
+    auto writeString = [&](std::ostream& o, const std::string_view& name, const std::string& value) {
+        if(value.empty())
+            return;
+        o << " /" << name << " (";
+        for(auto cc : value) {
+            if(cc == '(' || cc == ')' || cc == '\\')
+                o << '\\';
+            o << cc;
+        }
+
+        o << ')';
+    };
+
+    std::ostringstream info;
+    info << "<<";
+    writeString(info, "Title", m_book->title());
+    writeString(info, "Subject", m_book->subject());
+    writeString(info, "Author", m_book->author());
+    writeString(info, "Creator", m_book->creator());
+    writeString(info, "CreationDate", m_book->creationDate());
+    writeString(info, "ModDate", m_book->modificationDate());
+    info << " /Producer (htmlbook) >>\n";
+
+    beginObject(3);
+    write(info.str());
+    endObject();
+
+    auto xrefOffset = m_offset;
+    std::ostringstream xref;
+    xref << "xref\n0 " << m_objectOffsets.size() << '\n';
+    xref << "0000000000 65535 f \n";
+    for(size_t object = 1; object < m_objectOffsets.size(); ++object)
+        xref << std::setw(10) << std::setfill('0') << m_objectOffsets[object] << " 00000 n \n";
+    xref << "trailer\n<< /Size " << m_objectOffsets.size() << " /Root 1 0 R /Info 3 0 R >>\n";
+    xref << "startxref\n" << xrefOffset << "\n%%EOF\n";
+    write(xref.str());
+    m_output.flush();
+}
+
+int PDFWriter::allocateObject()
+{
+    m_objectOffsets.push_back(0);
+    return m_objectOffsets.size() - 1;
+}
+
+void PDFWriter::beginObject(int object)
+{
+    m_objectOffsets[object] = m_offset;
+    write(std::to_string(object));
+    write(" 0 obj\n");
+}
+
+void PDFWriter::endObject()
+{
+    write("endobj\n");
+}
+
+void PDFWriter::writeStream(int object, const std::string& dictionary, const char* data, size_t length)
+{
+    beginObject(object);
+    write("<< /Length ");
+    write(std::to_string(length));
+    write(dictionary);
+    write(" >>\nstream\n");
+    write(std::string_view(data, length));
+    write("\nendstream\n");
+    endObject();
+}
+
+void PDFWriter::write(const std::string_view& data)
+{
+    m_output.write(data.data(), data.length());
+    m_offset += data.length();
+}
+
+int PDFWriter::fontObject(int weight, bool italic)
+{
+    auto bold = weight >= 600;
+    auto& object = m_fontObjects[std::make_pair(bold, italic)];
+    if(object == 0) {
+        static const char* names[] = {
+            "Helvetica",
+            "Helvetica-Oblique",
+            "Helvetica-Bold",
+            "Helvetica-BoldOblique"
+        };
+
+        object = allocateObject();
+        beginObject(object);
+        write("<< /Type /Font /Subtype /Type1 /BaseFont /");
+        write(names[bold * 2 + italic]);
+        write(" /Encoding /WinAnsiEncoding >>\n");
+        endObject();
+    }
+
+    m_pageFonts.emplace(object, "F" + std::to_string(object));
+    return object;
+}
+
+int PDFWriter::imageObject(const Image* image)
+{
+    auto& object = m_imageObjects[image];
+    if(object == 0) {
+        auto width = image->width();
+        auto height = image->height();
+        auto pixels = image->data();
+
+        std::string color(width * height * 3, 0);
+        std::string alpha(width * height, 0);
+        bool opaque = true;
+        for(int index = 0; index < width * height; ++index) {
+            color[index * 3 + 0] = pixels[index * 4 + 0];
+            color[index * 3 + 1] = pixels[index * 4 + 1];
+            color[index * 3 + 2] = pixels[index * 4 + 2];
+            alpha[index] = pixels[index * 4 + 3];
+            if(pixels[index * 4 + 3] != 255) {
+                opaque = false;
+            }
+        }
+
+        std::ostringstream dictionary;
+        dictionary << " /Type /XObject /Subtype /Image /Width " << width << " /Height " << height << " /BitsPerComponent 8";
+
+        int maskObject = 0;
+        if(!opaque) {
+            maskObject = allocateObject();
+            writeStream(maskObject, dictionary.str() + " /ColorSpace /DeviceGray", alpha.data(), alpha.length());
+            dictionary << " /SMask " << maskObject << " 0 R";
+        }
+
+        object = allocateObject();
+        writeStream(object, dictionary.str() + " /ColorSpace /DeviceRGB", color.data(), color.length());
+    }
+
+    m_pageImages.emplace(object, "Im" + std::to_string(object));
+    return object;
+}
+
+void PDFWriter::paintBox(const Box* box, float x, float y)
+{
+    if(auto frame = to<BoxFrame>(box)) {
+        x += frame->x();
+        y += frame->y();
+        if(!intersects(y, y + frame->height()))
+            return;
+        paintDecorations(frame, x, y);
+        if(auto image = to<ImageBox>(box)) {
+            if(image->image() && image->style()->visibility() == Visibility::Visible) {
+                auto contentX = x + frame->borderLeft() + frame->paddingLeft();
+                auto contentY = y + frame->borderTop() + frame->paddingTop();
+                drawImage(image->image().get(), contentX, contentY, frame->contentWidth(), frame->contentHeight());
+            }
+        }
+    }
+
+    auto block = to<BlockBox>(box);
+    if(auto flow = to<BlockFlowBox>(box); flow && flow->lineLayout()) {
+        paintLines(flow, x, y);
+    } else {
+        paintChildren(box, x, y);
+    }
+
+    if(block) {
+        paintPositionedBoxes(block, x, y);
+    }
+}
+
+void PDFWriter::paintChildren(const Box* box, float x, float y)
+{
+    auto& lastSkippedChild = m_lastSkippedChild[box];
+    auto child = lastSkippedChild ? lastSkippedChild->nextBox() : box->firstBox();
+    auto flowBlock = is<BlockFlowBox>(*box);
+    auto skipping = true;
+    for(; child; child = child->nextBox()) {
+        auto frame = to<BoxFrame>(child);
+        if(child->isPositioned() || (frame && y + frame->y() + frame->height() <= m_windowTop)) {
+            if(skipping)
+                lastSkippedChild = child;
+            continue;
+        }
+
+        skipping = false;
+        if(frame && y + frame->y() >= m_windowBottom && flowBlock && !child->isFloating())
+            break;
+        paintBox(child, x, y);
+    }
+}
+
+void PDFWriter::paintLines(const BlockBox* block, float x, float y)
+{
+    auto& flow = to<BlockFlowBox>(*block);
+    for(auto& line : flow.lineLayout()->lines()) {
+        auto top = y + line->y();
+        if(top >= m_windowBottom)
+            break;
+        if(top + line->height() <= m_windowTop)
+            continue;
+        paintLine(line.get(), block, x, y);
+    }
+
+    for(auto child = block->firstBox(); child; child = child->nextBox()) {
+        if(child->isFloating()) {
+            paintBox(child, x, y);
+        }
+    }
+}
+
+void PDFWriter::paintLine(const LineBox* line, const BlockBox* block, float x, float y)
+{
+    if(auto textLine = to<TextLineBox>(line)) {
+        auto& style = textLine->box()->style();
+        if(style->visibility() != Visibility::Visible)
+            return;
+        auto baseline = style->fontSize() * 0.8f;
+        if(auto face = style->fontFace())
+            baseline = face->ascent() * face->scale(style->fontSize());
+        auto italic = style->fontStyle() != FontStyle::Normal;
+        drawText(textLine->text(), x + line->x(), y + line->y() + baseline, style->fontSize(), style->fontWeight(), italic, style->color());
+        return;
+    }
+
+    if(auto replacedLine = to<ReplacedLineBox>(line)) {
+        paintBox(replacedLine->box(), x, y);
+        return;
+    }
+
+    if(auto flowLine = to<FlowLineBox>(line)) {
+        for(auto child : flowLine->children()) {
+            paintLine(child, block, x, y);
+        }
+    }
+}
+
+void PDFWriter::paintPositionedBoxes(const BlockBox* block, float x, float y)
+{
+    if(auto boxes = block->positionedBoxes()) {
+        for(auto box : *boxes) {
+            paintBox(box, x, y);
+        }
+    }
+}
+
+void PDFWriter::paintDecorations(const BoxFrame* box, float x, float y)
+{
+    auto& style = box->style();
+    if(style->visibility() != Visibility::Visible || box->isBoxView())
+        return;
+    fillRect(x, y, box->width(), box->height(), style->backgroundColor());
+    if(style->borderTopStyle() > LineStyle::Hidden)
+        fillRect(x, y, box->width(), box->borderTop(), style->borderTopColor());
+    if(style->borderBottomStyle() > LineStyle::Hidden)
+        fillRect(x, y + box->height() - box->borderBottom(), box->width(), box->borderBottom(), style->borderBottomColor());
+    if(style->borderLeftStyle() > LineStyle::Hidden)
+        fillRect(x, y, box->borderLeft(), box->height(), style->borderLeftColor());
+    if(style->borderRightStyle() > LineStyle::Hidden) {
+        fillRect(x + box->width() - box->borderRight(), y, box->borderRight(), box->height(), style->borderRightColor());
+    }
+}
+
+void PDFWriter::fillRect(float x, float y, float width, float height, const Color& color)
+{
+    if(color.alpha() == 0 || width <= 0 || height <= 0)
+        return;
+    m_content << color.red() / 255.f << ' ' << color.green() / 255.f << ' ' << color.blue() / 255.f << " rg\n";
+    m_content << x << ' ' << y << ' ' << width << ' ' << height << " re f\n";
+}
+
+void PDFWriter::drawImage(const Image* image, float x, float y, float width, float height)
+{
+    if(width <= 0 || height <= 0)
+        return;
+    auto object = imageObject(image);
+    m_content << "q " << width << " 0 0 " << -height << ' ' << x << ' ' << y + height << " cm /Im" << object << " Do Q\n";
+}
+
+void PDFWriter::drawText(const std::string_view& text, float x, float y, float fontSize, int weight, bool italic, const Color& color)
+{
+    if(color.alpha() == 0 || text.empty())
+        return;
+    auto object = fontObject(weight, italic);
+    m_content << "BT\n";
+    m_content << color.red() / 255.f << ' ' << color.green() / 255.f << ' ' << color.blue() / 255.f << " rg\n";
+    m_content << "/F" << object << ' ' << fontSize << " Tf\n";
+    m_content << "1 0 0 -1 " << x << ' ' << y << " Tm\n";
+    m_content << '(';
+    for(size_t index = 0; index < text.length(); ++index) {
+        uint32_t cp = static_cast<uint8_t>(text[index]);
+        if(cp >= 0x80) {
+            int count = cp >= 0xF0 ? 3 : cp >= 0xE0 ? 2 : 1;
+            cp &= 0x3F >> count;
+            while(count-- > 0 && index + 1 < text.length())
+                cp = (cp << 6) | (static_cast<uint8_t>(text[++index]) & 0x3F);
+            if(cp < 0xA0 || cp > 0xFF) {
+                cp = '?';
+            }
+        }
+
+        if(cp == '(' || cp == ')' || cp == '\\')
+            m_content << '\\';
+        m_content << static_cast<char>(cp);
+    }
+
+    m_content << ") Tj\nET\n";
+}
+
+} // namespace htmlbook
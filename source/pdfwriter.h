@@ -0,0 +1,72 @@
+#ifndef PDFWRITER_H
+#define PDFWRITER_H
+
+#include "pointer.h"
+
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+namespace htmlbook {
+
+class Book;
+class Box;
+class BoxView;
+class BoxFrame;
+class BlockBox;
+class LineBox;
+class Image;
+class Color;
+
+class PDFWriter {
+public:
+    PDFWriter(std::ostream& output, const Book* book);
+
+    void writePage(const BoxView* view, size_t pageIndex);
+    void finish();
+
+private:
+    int allocateObject();
+    void beginObject(int object);
+    void endObject();
+    void writeStream(int object, const std::string& dictionary, const char* data, size_t length);
+    void write(const std::string_view& data);
+
+    int fontObject(int weight, bool italic);
+    int imageObject(const Image* image);
+
+    void paintBox(const Box* box, float x, float y);
+    void paintChildren(const Box* box, float x, float y);
+    void paintLines(const BlockBox* block, float x, float y);
+    void paintLine(const LineBox* line, const BlockBox* block, float x, float y);
+    void paintPositionedBoxes(const BlockBox* block, float x, float y);
+    void paintDecorations(const BoxFrame* box, float x, float y);
+
+    void fillRect(float x, float y, float width, float height, const Color& color);
+    void drawImage(const Image* image, float x, float y, float width, float height);
+    void drawText(const std::string_view& text, float x, float y, float fontSize, int weight, bool italic, const Color& color);
+
+    bool intersects(float top, float bottom) const { return bottom > m_windowTop && top < m_windowBottom; }
+
+    std::ostream& m_output;
+    const Book* m_book;
+    size_t m_offset{0};
+    std::vector<size_t> m_objectOffsets;
+    std::vector<int> m_pageObjects;
+    std::map<std::pair<int, bool>, int> m_fontObjects;
+    std::map<const Image*, int> m_imageObjects;
+    std::unordered_map<const Box*, const Box*> m_lastSkippedChild;
+
+    std::ostringstream m_content;
+    std::map<int, std::string> m_pageFonts;
+    std::map<int, std::string> m_pageImages;
+    float m_windowTop{0};
+    float m_windowBottom{0};
+};
+
+} // namespace htmlbook
+
+#endif // PDFWRITER_H
@@ -27,19 +27,28 @@ class RefCounted {
 public:
     RefCounted() = default;
 
-    void ref() { ++m_refCount; }
+    void ref() {
+        if(m_refCount != kStaticRefCount) {
+            ++m_refCount;
+        }
+    }
+
     void deref() {
-        if(--m_refCount == 0) {
+        if(m_refCount != kStaticRefCount && --m_refCount == 0) {
             delete static_cast<T*>(this);
         }
     }
 
+    void makeStatic() { m_refCount = kStaticRefCount; }
+    bool isStatic() const { return m_refCount == kStaticRefCount; }
+
     uint32_t refCount() const { return m_refCount; }
     bool hasOneRefCount() const { return m_refCount == 1; }
 
 private:
     RefCounted(const RefCounted&) = delete;
     RefCounted& operator=(const RefCounted&) = delete;
+    static constexpr uint32_t kStaticRefCount = UINT32_MAX;
     uint32_t m_refCount{1};
 };
 